@@ -45,6 +45,8 @@ public class AssetBatchValidator : ModuleRules
                 "AssetRegistry",
                 "ContentBrowser",
                 "InputCore",
+                "ImageCore",
+                "DirectoryWatcher",
 				"Slate",
 				"SlateCore",
 				"EditorStyle"
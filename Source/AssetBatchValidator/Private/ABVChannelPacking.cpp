@@ -0,0 +1,223 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ABVChannelPacking.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "Math/VectorRegister.h"
+#include "Misc/Paths.h"
+
+bool ABV_ClassifyPackChannel(const FString& AssetName, EABVPackChannel& OutChannel, FString& OutStem)
+{
+    const FString Name = FPaths::GetBaseFilename(AssetName);
+
+    int32 Underscore = INDEX_NONE;
+    if (!Name.FindLastChar(TEXT('_'), Underscore) || Underscore == 0)
+    {
+        return false;
+    }
+
+    const FString Token = Name.Mid(Underscore + 1).ToLower();
+    if (Token == TEXT("ao") || Token == TEXT("occ") || Token == TEXT("occlusion") || Token == TEXT("ambientocclusion"))
+    {
+        OutChannel = EABVPackChannel::Occlusion;
+    }
+    else if (Token == TEXT("rgh") || Token == TEXT("rough") || Token == TEXT("roughness"))
+    {
+        OutChannel = EABVPackChannel::Roughness;
+    }
+    else if (Token == TEXT("met") || Token == TEXT("metal") || Token == TEXT("metallic") || Token == TEXT("metalness"))
+    {
+        OutChannel = EABVPackChannel::Metallic;
+    }
+    else if (Token == TEXT("opacity") || Token == TEXT("alpha") || Token == TEXT("mask"))
+    {
+        OutChannel = EABVPackChannel::Opacity;
+    }
+    else
+    {
+        return false;
+    }
+
+    OutStem = Name.Left(Underscore);
+    return true;
+}
+
+bool ABV_IsSingleChannelTexture(const FAssetData& AD)
+{
+    FString Value;
+    if (AD.GetTagValue(TEXT("CompressionSettings"), Value))
+    {
+        // 枚举 tag 可能带类型前缀
+        int32 Colon = INDEX_NONE;
+        if (Value.FindLastChar(TEXT(':'), Colon))
+        {
+            Value.RightChopInline(Colon + 1);
+        }
+        // TC_Masks 不算：它本来就是多通道遮罩（RGB 各存一张），不是单通道
+        if (Value == TEXT("TC_Grayscale") || Value == TEXT("TC_Alpha"))
+        {
+            return true;
+        }
+    }
+
+    if (AD.GetTagValue(TEXT("Format"), Value))
+    {
+        Value.RemoveFromStart(TEXT("PF_"));
+        Value.RemoveFromStart(TEXT("TSF_"));
+        return Value == TEXT("G8") || Value == TEXT("G16");
+    }
+    return false;
+}
+
+void ABV_FindPackingCandidates(const TArray<FAssetData>& Assets, TArray<FABVPackingCandidate>& OutCandidates)
+{
+    OutCandidates.Reset();
+
+    struct FGroup
+    {
+        FABVPackingCandidate Candidate;
+        bool bValid = true;
+    };
+    TMap<FString, FGroup> Groups;
+
+    // 已经存在的打包贴图不再推荐
+    TSet<FString> ExistingPaths;
+    for (const FAssetData& AD : Assets)
+    {
+        ExistingPaths.Add(AD.GetObjectPathString());
+    }
+
+    for (const FAssetData& AD : Assets)
+    {
+        EABVPackChannel Channel;
+        FString Stem;
+        if (!ABV_ClassifyPackChannel(AD.AssetName.ToString(), Channel, Stem))
+        {
+            continue;
+        }
+
+        // 名字像通道贴图但实际是彩色的（T_Rock_Mask 存的是 RGB 遮罩等），打包会丢数据
+        if (!ABV_IsSingleChannelTexture(AD))
+        {
+            continue;
+        }
+
+        // 只读 tag，不加载贴图
+        FString Dimensions;
+        FString WStr;
+        FString HStr;
+        if (!AD.GetTagValue(TEXT("Dimensions"), Dimensions) || !Dimensions.Split(TEXT("x"), &WStr, &HStr))
+        {
+            continue;
+        }
+        const int32 W = FCString::Atoi(*WStr);
+        const int32 H = FCString::Atoi(*HStr);
+
+        const FString PackagePath = AD.PackagePath.ToString();
+        FGroup& G = Groups.FindOrAdd(PackagePath + TEXT("|") + Stem.ToLower());
+        FABVPackingCandidate& C = G.Candidate;
+        if (C.Stem.IsEmpty())
+        {
+            C.PackagePath = PackagePath;
+            C.Stem = Stem;
+            C.Width = W;
+            C.Height = H;
+        }
+
+        FString& Slot = C.ChannelPaths[static_cast<int32>(Channel)];
+        if (!Slot.IsEmpty() || C.Width != W || C.Height != H)
+        {
+            // 同一通道有两张（T_A_Rough 和 T_A_Roughness）或尺寸不一致，需要人工处理
+            G.bValid = false;
+            continue;
+        }
+        Slot = AD.GetObjectPathString();
+    }
+
+    for (TPair<FString, FGroup>& Pair : Groups)
+    {
+        FABVPackingCandidate& C = Pair.Value.Candidate;
+        if (!Pair.Value.bValid) continue;
+        if (ExistingPaths.Contains(C.GetPackedObjectPath())) continue;
+
+        int32 NumChannels = 0;
+        int64 SeparateBytes = 0;
+        for (const FString& Path : C.ChannelPaths)
+        {
+            if (Path.IsEmpty()) continue;
+            NumChannels++;
+            SeparateBytes += ABV_EstimateTextureBytes(C.Width, C.Height, EABVTextureKind::Mask);
+        }
+        if (NumChannels < 2) continue;
+
+        // 打包后：无 alpha 为 BC1 级别，有 alpha 为 BC3/BC7 级别
+        const bool bHasAlpha = !C.ChannelPaths[static_cast<int32>(EABVPackChannel::Opacity)].IsEmpty();
+        const int64 Pixels = static_cast<int64>(C.Width) * C.Height;
+        const int64 PackedBytes = (bHasAlpha ? Pixels : Pixels / 2) * 4 / 3;
+
+        C.NumSamplersSaved = NumChannels - 1;
+        C.EstimatedSavingsBytes = FMath::Max<int64>(0, SeparateBytes - PackedBytes);
+        OutCandidates.Add(MoveTemp(C));
+    }
+
+    OutCandidates.Sort([](const FABVPackingCandidate& A, const FABVPackingCandidate& B)
+    {
+        return A.EstimatedSavingsBytes > B.EstimatedSavingsBytes;
+    });
+}
+
+void ABV_InterleaveChannels(const uint8* const Planes[4], const uint8 Fill[4], int64 NumPixels, uint8* OutBGRA)
+{
+    // 输出字节序 B G R A：B = Metallic, G = Roughness, R = Occlusion, A = Opacity
+    const uint8* const PB = Planes[static_cast<int32>(EABVPackChannel::Metallic)];
+    const uint8* const PG = Planes[static_cast<int32>(EABVPackChannel::Roughness)];
+    const uint8* const PR = Planes[static_cast<int32>(EABVPackChannel::Occlusion)];
+    const uint8* const PA = Planes[static_cast<int32>(EABVPackChannel::Opacity)];
+    const uint8 FB = Fill[static_cast<int32>(EABVPackChannel::Metallic)];
+    const uint8 FG = Fill[static_cast<int32>(EABVPackChannel::Roughness)];
+    const uint8 FR = Fill[static_cast<int32>(EABVPackChannel::Occlusion)];
+    const uint8 FA = Fill[static_cast<int32>(EABVPackChannel::Opacity)];
+
+    int64 i = 0;
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+    for (; i + 16 <= NumPixels; i += 16)
+    {
+        uint8x16x4_t V;
+        V.val[0] = PB ? vld1q_u8(PB + i) : vdupq_n_u8(FB);
+        V.val[1] = PG ? vld1q_u8(PG + i) : vdupq_n_u8(FG);
+        V.val[2] = PR ? vld1q_u8(PR + i) : vdupq_n_u8(FR);
+        V.val[3] = PA ? vld1q_u8(PA + i) : vdupq_n_u8(FA);
+        vst4q_u8(OutBGRA + i * 4, V);
+    }
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+    for (; i + 16 <= NumPixels; i += 16)
+    {
+        const __m128i B = PB ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(PB + i)) : _mm_set1_epi8(static_cast<char>(FB));
+        const __m128i G = PG ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(PG + i)) : _mm_set1_epi8(static_cast<char>(FG));
+        const __m128i R = PR ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(PR + i)) : _mm_set1_epi8(static_cast<char>(FR));
+        const __m128i A = PA ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(PA + i)) : _mm_set1_epi8(static_cast<char>(FA));
+
+        // 先交错成 BG / RA 字节对，再交错成 BGRA 四元组
+        const __m128i BGLo = _mm_unpacklo_epi8(B, G);
+        const __m128i BGHi = _mm_unpackhi_epi8(B, G);
+        const __m128i RALo = _mm_unpacklo_epi8(R, A);
+        const __m128i RAHi = _mm_unpackhi_epi8(R, A);
+
+        __m128i* Out = reinterpret_cast<__m128i*>(OutBGRA + i * 4);
+        _mm_storeu_si128(Out + 0, _mm_unpacklo_epi16(BGLo, RALo));
+        _mm_storeu_si128(Out + 1, _mm_unpackhi_epi16(BGLo, RALo));
+        _mm_storeu_si128(Out + 2, _mm_unpacklo_epi16(BGHi, RAHi));
+        _mm_storeu_si128(Out + 3, _mm_unpackhi_epi16(BGHi, RAHi));
+    }
+#endif
+
+    for (; i < NumPixels; ++i)
+    {
+        uint8* Px = OutBGRA + i * 4;
+        Px[0] = PB ? PB[i] : FB;
+        Px[1] = PG ? PG[i] : FG;
+        Px[2] = PR ? PR[i] : FR;
+        Px[3] = PA ? PA[i] : FA;
+    }
+}
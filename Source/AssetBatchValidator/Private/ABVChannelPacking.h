@@ -0,0 +1,24 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ABVTypes.h"
+
+struct FAssetData;
+
+// Slot for a texture name like T_Rock_AO / T_Rock_Roughness / T_Rock_Metal, and the name without the channel suffix.
+// Returns false if the last name token is not a single-channel suffix (one-letter tokens are too ambiguous to count).
+bool ABV_ClassifyPackChannel(const FString& AssetName, EABVPackChannel& OutChannel, FString& OutStem);
+
+// True if the registry tags say the texture holds one channel:
+// CompressionSettings TC_Grayscale / TC_Alpha, or a G8 / G16 format. TC_Masks is multi-channel (one mask per channel).
+bool ABV_IsSingleChannelTexture(const FAssetData& AD);
+
+// Groups sibling single-channel textures by folder + stem using registry tags only (no loads).
+// Groups need at least two slots and matching source dimensions.
+void ABV_FindPackingCandidates(const TArray<FAssetData>& Assets, TArray<FABVPackingCandidate>& OutCandidates);
+
+// Interleaves up to four 8-bit planes into BGRA8 (the FImage / TSF_BGRA8 byte order).
+// Null planes are filled with Fill[slot]. SSE2 / NEON, scalar tail.
+void ABV_InterleaveChannels(const uint8* const Planes[4], const uint8 Fill[4], int64 NumPixels, uint8* OutBGRA);
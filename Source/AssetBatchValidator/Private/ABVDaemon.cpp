@@ -0,0 +1,595 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ABVDaemon.h"
+
+#include "AssetBatchValidator.h"
+#include "ABVMemoryTracker.h"
+#include "ABVResultsCache.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Containers/Ticker.h"
+#include "Engine/Texture2D.h"
+#include "FileHelpers.h"
+#include "HAL/FileManager.h"
+#include "CoreGlobals.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+#if ABV_WITH_DAEMON
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// 单行请求的上限：没有换行的数据不能无限制地堆在内存里
+static constexpr int32 ABV_DaemonMaxRequestBytes = 1024 * 1024;
+
+FABVDaemon::FABVDaemon(const FString& InSocketPath, const FABVRuleSettings& InRules)
+    : SocketPath(InSocketPath)
+    , Rules(InRules)
+{
+}
+
+FABVDaemon::~FABVDaemon()
+{
+#if ABV_WITH_DAEMON
+    for (TUniquePtr<FClient>& Client : Clients)
+    {
+        CloseClient(*Client);
+    }
+    if (ListenFd >= 0)
+    {
+        close(ListenFd);
+        unlink(TCHAR_TO_UTF8(*SocketPath));
+    }
+#endif
+}
+
+FString FABVDaemon::GetDefaultSocketPath()
+{
+    return FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("ABV") / TEXT("daemon.sock"));
+}
+
+bool FABVDaemon::Start()
+{
+#if ABV_WITH_DAEMON
+    // 客户端断开时 send 不能把整个进程带走
+    signal(SIGPIPE, SIG_IGN);
+
+    sockaddr_un Addr = {};
+    Addr.sun_family = AF_UNIX;
+    const FTCHARToUTF8 PathUtf8(*SocketPath);
+    if (PathUtf8.Length() >= static_cast<int32>(sizeof(Addr.sun_path)))
+    {
+        UE_LOG(LogTemp, Error, TEXT("ABV Daemon: socket path too long (%d bytes, max %d): %s. Use -Socket=<short path>."),
+            PathUtf8.Length(), static_cast<int32>(sizeof(Addr.sun_path)) - 1, *SocketPath);
+        return false;
+    }
+    FMemory::Memcpy(Addr.sun_path, PathUtf8.Get(), PathUtf8.Length());
+
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(SocketPath), true);
+    unlink(PathUtf8.Get());   // 上次异常退出留下的 socket 文件
+
+    // listen 之前收紧权限：只有本用户能连接，其他用户不能让守护进程加载、修复或保存资源
+    ListenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (ListenFd < 0
+        || bind(ListenFd, reinterpret_cast<const sockaddr*>(&Addr), sizeof(Addr)) != 0
+        || chmod(PathUtf8.Get(), S_IRUSR | S_IWUSR) != 0
+        || listen(ListenFd, 16) != 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("ABV Daemon: cannot listen on %s (errno %d)"), *SocketPath, errno);
+        return false;
+    }
+    fcntl(ListenFd, F_SETFL, fcntl(ListenFd, F_GETFL) | O_NONBLOCK);
+
+    UE_LOG(LogTemp, Display, TEXT("ABV Daemon: listening on %s"), *SocketPath);
+    return true;
+#else
+    UE_LOG(LogTemp, Error, TEXT("ABV Daemon: Unix sockets are not supported on this platform"));
+    return false;
+#endif
+}
+
+void FABVDaemon::Run()
+{
+#if ABV_WITH_DAEMON
+    double LastTime = FPlatformTime::Seconds();
+    TArray<pollfd> PollFds;
+
+    while (!bShutdownRequested && !IsEngineExitRequested())
+    {
+        PollFds.Reset();
+        PollFds.Add({ ListenFd, POLLIN, 0 });
+        for (const TUniquePtr<FClient>& Client : Clients)
+        {
+            // 对端已关闭写端的客户端不再读（EOF 会让 POLLIN 一直就绪），只等应答发完
+            const short Events = (Client->bClosing ? 0 : POLLIN) | (Client->OutBuffer.Num() > 0 ? POLLOUT : 0);
+            PollFds.Add({ Client->Fd, Events, 0 });
+        }
+
+        // 短超时：没有请求时也要 tick，registry 的异步工作需要推进
+        poll(PollFds.GetData(), PollFds.Num(), 50);
+
+        if (PollFds[0].revents & POLLIN)
+        {
+            AcceptClients();
+        }
+
+        // 新接入的客户端不在本轮 PollFds 里，只处理前 N 个
+        const int32 NumPolled = PollFds.Num() - 1;
+        for (int32 i = NumPolled - 1; i >= 0; --i)
+        {
+            FClient& Client = *Clients[i];
+            const short REvents = PollFds[i + 1].revents;
+
+            bool bKeep = true;
+            if (!Client.bClosing && (REvents & (POLLIN | POLLHUP | POLLERR)))
+            {
+                bKeep = ReadClient(Client);
+            }
+            if (bKeep && Client.OutBuffer.Num() > 0)
+            {
+                bKeep = FlushClient(Client);
+            }
+            if (bKeep && Client.bClosing && Client.OutBuffer.Num() == 0)
+            {
+                bKeep = false;
+            }
+            if (!bKeep)
+            {
+                CloseClient(Client);
+                Clients.RemoveAt(i);
+            }
+        }
+
+        // 应答发出去之后再释放这次请求加载的贴图（ValidateAssets 自己释放验证时的加载，这里是 fix 留下的），
+        // 常驻进程的内存不随请求数增长
+        FABVMemoryTracker::Get().ReleaseScanLoads();
+
+        const double Now = FPlatformTime::Seconds();
+        FTSTicker::GetCoreTicker().Tick(static_cast<float>(Now - LastTime));
+        LastTime = Now;
+    }
+
+    // shutdown 的应答尽量发出去
+    for (TUniquePtr<FClient>& Client : Clients)
+    {
+        FlushClient(*Client);
+    }
+#endif
+}
+
+void FABVDaemon::AcceptClients()
+{
+#if ABV_WITH_DAEMON
+    for (;;)
+    {
+        const int32 Fd = accept(ListenFd, nullptr, nullptr);
+        if (Fd < 0)
+        {
+            break;   // EAGAIN：没有更多连接
+        }
+        fcntl(Fd, F_SETFL, fcntl(Fd, F_GETFL) | O_NONBLOCK);
+
+        TUniquePtr<FClient> Client = MakeUnique<FClient>();
+        Client->Fd = Fd;
+        Clients.Add(MoveTemp(Client));
+    }
+#endif
+}
+
+bool FABVDaemon::ReadClient(FClient& Client)
+{
+#if ABV_WITH_DAEMON
+    ANSICHAR Chunk[4096];
+    for (;;)
+    {
+        const ssize_t Read = recv(Client.Fd, Chunk, sizeof(Chunk), 0);
+        if (Read > 0)
+        {
+            Client.InBuffer.Append(Chunk, static_cast<int32>(Read));
+            if (Client.InBuffer.Num() >= ABV_DaemonMaxRequestBytes)
+            {
+                break;   // 先处理已收到的完整行，剩下的下一轮 poll 再读
+            }
+            continue;
+        }
+        if (Read == 0)
+        {
+            // 客户端关闭写端：已经收到的完整请求照常处理，应答发完再关
+            Client.bClosing = true;
+            break;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            break;
+        }
+        if (errno != EINTR)
+        {
+            return false;
+        }
+    }
+
+    // 按行切分，最后不完整的一行留到下次
+    int32 LineStart = 0;
+    for (int32 i = 0; i < Client.InBuffer.Num() && !bShutdownRequested; ++i)
+    {
+        if (Client.InBuffer[i] != '\n') continue;
+
+        const int32 Len = (i > LineStart && Client.InBuffer[i - 1] == '\r') ? i - 1 - LineStart : i - LineStart;
+        const FString Line(FUTF8ToTCHAR(Client.InBuffer.GetData() + LineStart, Len));
+        LineStart = i + 1;
+
+        if (!Line.TrimStartAndEnd().IsEmpty())
+        {
+            HandleLine(Client, Line);
+        }
+    }
+    Client.InBuffer.RemoveAt(0, LineStart, EAllowShrinking::No);
+
+    if (Client.InBuffer.Num() >= ABV_DaemonMaxRequestBytes)
+    {
+        Send(Client, FString::Printf(TEXT("ERR request too long (max %d bytes per line)"), ABV_DaemonMaxRequestBytes));
+        Client.InBuffer.Empty();
+        Client.bClosing = true;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool FABVDaemon::FlushClient(FClient& Client)
+{
+#if ABV_WITH_DAEMON
+    while (Client.OutBuffer.Num() > 0)
+    {
+        const ssize_t Sent = send(Client.Fd, Client.OutBuffer.GetData(), Client.OutBuffer.Num(), 0);
+        if (Sent > 0)
+        {
+            Client.OutBuffer.RemoveAt(0, static_cast<int32>(Sent), EAllowShrinking::No);
+            continue;
+        }
+        if (Sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+        {
+            return true;   // 等 POLLOUT
+        }
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void FABVDaemon::CloseClient(FClient& Client)
+{
+#if ABV_WITH_DAEMON
+    if (Client.Fd >= 0)
+    {
+        close(Client.Fd);
+        Client.Fd = -1;
+    }
+#endif
+}
+
+void FABVDaemon::Send(FClient& Client, const FString& Line)
+{
+    const FTCHARToUTF8 Utf8(*Line);
+    Client.OutBuffer.Append(Utf8.Get(), Utf8.Length());
+    Client.OutBuffer.Add('\n');
+}
+
+void FABVDaemon::HandleLine(FClient& Client, const FString& Line)
+{
+    TArray<FString> Fields;
+    Line.ParseIntoArray(Fields, TEXT("\t"));
+    for (FString& F : Fields)
+    {
+        F.TrimStartAndEndInline();
+    }
+    Fields.RemoveAll([](const FString& F) { return F.IsEmpty(); });
+    if (Fields.Num() == 0) return;
+
+    // 兼容手敲命令：只有一个字段时按空格切分
+    if (Fields.Num() == 1 && Fields[0].Contains(TEXT(" ")))
+    {
+        const FString Single = Fields[0];
+        Single.ParseIntoArrayWS(Fields);
+    }
+
+    const FString Verb = Fields[0].ToLower();
+    const TArray<FString> Args(Fields.GetData() + 1, Fields.Num() - 1);
+    NumRequests++;
+
+    if (Verb == TEXT("validate"))
+    {
+        HandleValidate(Client, Args);
+    }
+    else if (Verb == TEXT("validate-root"))
+    {
+        HandleValidateRoot(Client, Args.Num() > 0 ? Args[0] : FString(TEXT("/Game")));
+    }
+    else if (Verb == TEXT("delta"))
+    {
+        HandleDelta(Client, Args);
+    }
+    else if (Verb == TEXT("fix"))
+    {
+        HandleFix(Client, Args);
+    }
+    else if (Verb == TEXT("report"))
+    {
+        if (Args.Num() == 0)
+        {
+            Send(Client, TEXT("ERR report needs a csv file name"));
+            return;
+        }
+        HandleReport(Client, Args[0]);
+    }
+    else if (Verb == TEXT("stats"))
+    {
+        HandleStats(Client);
+    }
+    else if (Verb == TEXT("shutdown"))
+    {
+        Send(Client, TEXT("OK shutdown"));
+        bShutdownRequested = true;
+    }
+    else
+    {
+        Send(Client, FString::Printf(TEXT("ERR unknown request '%s'"), *Verb));
+    }
+}
+
+void FABVDaemon::ValidateWarm(const TArray<FAssetData>& Assets, TArray<FABVTextureIssue>& OutIssues)
+{
+    OutIssues.Reset();
+
+    TArray<FAssetData> Misses;
+    TArray<FIoHash> MissHashes;
+    for (const FAssetData& AD : Assets)
+    {
+        const FString ObjectPath = AD.GetObjectPathString();
+        const FIoHash PackageHash = ABV_GetPackageSavedHash(ObjectPath);
+
+        const FWarmResult* Warm = WarmResults.Find(ObjectPath);
+        if (Warm && !PackageHash.IsZero() && Warm->PackageHash == PackageHash)
+        {
+            OutIssues.Add(Warm->Issue);
+            NumWarmHits++;
+            continue;
+        }
+        Misses.Add(AD);
+        NumWarmMisses++;
+    }
+
+    if (Misses.Num() == 0) return;
+
+    FAssetBatchValidatorModule& Mod =
+        FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
+
+    TArray<FABVTextureIssue> Fresh;
+    Mod.ValidateAssets(Misses, Rules, Fresh);
+
+    for (const FABVTextureIssue& Issue : Fresh)
+    {
+        FWarmResult& Warm = WarmResults.FindOrAdd(Issue.AssetPath);
+        Warm.PackageHash = ABV_GetPackageSavedHash(Issue.AssetPath);
+        Warm.Issue = Issue;
+    }
+    OutIssues.Append(MoveTemp(Fresh));
+}
+
+void FABVDaemon::SendResults(FClient& Client, const TArray<FABVTextureIssue>& Issues, double StartTime)
+{
+    int32 NumErrors = 0;
+    int32 NumWarnings = 0;
+    for (const FABVTextureIssue& I : Issues)
+    {
+        const TCHAR* Sev = TEXT("OK");
+        if (I.Severity == EABVIssueSeverity::Error) { Sev = TEXT("Error"); NumErrors++; }
+        else if (I.Severity == EABVIssueSeverity::Warning) { Sev = TEXT("Warning"); NumWarnings++; }
+
+        Send(Client, FString::Printf(TEXT("ROW\t%s\t%s\t%dx%d\t%s"), Sev, *I.AssetPath, I.Width, I.Height, *I.Message));
+    }
+
+    Send(Client, FString::Printf(TEXT("OK %d textures, %d errors, %d warnings, %.1f ms"),
+        Issues.Num(), NumErrors, NumWarnings, (FPlatformTime::Seconds() - StartTime) * 1000.0));
+    Client.LastResults = Issues;
+}
+
+void FABVDaemon::HandleValidate(FClient& Client, const TArray<FString>& Args)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    // 参数可以是文件路径，也可以是 /Game/... 形式的包名
+    TArray<FString> Files;
+    TSet<FName> PackageNames;
+    for (const FString& Arg : Args)
+    {
+        if (FPackageName::IsValidLongPackageName(Arg))
+        {
+            PackageNames.Add(FName(*Arg));
+        }
+        else if (FPackageName::IsValidObjectPath(Arg))
+        {
+            PackageNames.Add(FName(*FPackageName::ObjectPathToPackageName(Arg)));
+        }
+        else
+        {
+            Files.Add(Arg);
+        }
+    }
+    TArray<FName> FilePackages;
+    FAssetBatchValidatorModule::ConvertFilesToPackageNames(Files, FilePackages);
+    PackageNames.Append(FilePackages);
+
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    const FTopLevelAssetPath TextureClass = UTexture2D::StaticClass()->GetClassPathName();
+
+    TArray<FAssetData> Assets;
+    TArray<FAssetData> PackageAssets;
+    for (const FName& PkgName : PackageNames)
+    {
+        PackageAssets.Reset();
+        AssetRegistry.GetAssetsByPackageName(PkgName, PackageAssets, /*bIncludeOnlyOnDiskAssets=*/true);
+        for (const FAssetData& AD : PackageAssets)
+        {
+            if (AD.AssetClassPath == TextureClass)
+            {
+                Assets.Add(AD);
+            }
+        }
+    }
+
+    TArray<FABVTextureIssue> Issues;
+    ValidateWarm(Assets, Issues);
+    SendResults(Client, Issues, StartTime);
+}
+
+void FABVDaemon::HandleValidateRoot(FClient& Client, const FString& RootPath)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+    FARFilter Filter;
+    Filter.PackagePaths.Add(FName(*RootPath));
+    Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
+    Filter.bRecursivePaths = true;
+
+    TArray<FAssetData> Assets;
+    AssetRegistry.GetAssets(Filter, Assets);
+
+    TArray<FABVTextureIssue> Issues;
+    ValidateWarm(Assets, Issues);
+    SendResults(Client, Issues, StartTime);
+}
+
+void FABVDaemon::HandleDelta(FClient& Client, const TArray<FString>& Files)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    TArray<FString> AbsFiles;
+    for (const FString& File : Files)
+    {
+        AbsFiles.Add(FPaths::ConvertRelativePathToFull(FPaths::IsRelative(File) ? FPaths::ProjectDir() / File : File));
+    }
+
+    // 重新扫描后 package hash 会变，常驻结果自然失效；删除的文件也会从 registry 移除
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    AssetRegistry.ScanFilesSynchronous(AbsFiles, /*bForceRescan=*/true);
+
+    Send(Client, FString::Printf(TEXT("OK delta %d files, %.1f ms"), AbsFiles.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0));
+}
+
+void FABVDaemon::HandleFix(FClient& Client, const TArray<FString>& ObjectPaths)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    FAssetBatchValidatorModule& Mod =
+        FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
+
+    TArray<FAssetData> Assets;
+    TSet<FName> NotLoadedBefore;
+    for (const FString& Path : ObjectPaths)
+    {
+        const FAssetData AD = AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(Path));
+        if (AD.IsValid())
+        {
+            Assets.Add(AD);
+            if (!AD.IsAssetLoaded())
+            {
+                NotLoadedBefore.Add(AD.PackageName);
+            }
+        }
+    }
+
+    TArray<FABVTextureIssue> Issues;
+    Mod.ValidateAssets(Assets, Rules, Issues);
+
+    TArray<FString> ChangedPaths;
+    Mod.FixTextures(Issues, Rules.MaxTextureSize, ChangedPaths);
+
+    // 守护进程没有人点保存，修复后直接写回磁盘并更新 registry
+    TArray<UPackage*> Packages;
+    TArray<FString> Files;
+    for (const FString& Path : ChangedPaths)
+    {
+        if (UPackage* Package = FindObject<UPackage>(nullptr, *FPackageName::ObjectPathToPackageName(Path)))
+        {
+            Packages.AddUnique(Package);
+            Files.Add(FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension()));
+        }
+    }
+    if (Packages.Num() > 0)
+    {
+        UEditorLoadingAndSavingUtils::SavePackages(Packages, /*bOnlyDirty=*/true);
+        AssetRegistry.ScanFilesSynchronous(Files, /*bForceRescan=*/true);
+    }
+
+    // FixTextures 为修复重新加载的贴图，保存后包是干净的，应答之后和验证加载的一样释放
+    for (const FAssetData& AD : Assets)
+    {
+        if (NotLoadedBefore.Contains(AD.PackageName))
+        {
+            FABVMemoryTracker::Get().TrackScanLoad(AD.FastGetAsset(/*bLoad=*/false));
+        }
+    }
+
+    for (const FString& Path : ChangedPaths)
+    {
+        Send(Client, FString::Printf(TEXT("FIXED\t%s"), *Path));
+    }
+    Send(Client, FString::Printf(TEXT("OK fixed %d of %d, %.1f ms"),
+        ChangedPaths.Num(), ObjectPaths.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0));
+}
+
+void FABVDaemon::HandleReport(FClient& Client, const FString& CsvName)
+{
+    // 只能写到 Saved/ABV 下：任何能连上 socket 的客户端都不能借守护进程覆盖任意文件
+    FString Normalized = CsvName;
+    FPaths::NormalizeFilename(Normalized);
+    TArray<FString> Parts;
+    Normalized.ParseIntoArray(Parts, TEXT("/"));
+    if (Normalized.IsEmpty() || !FPaths::IsRelative(Normalized) || Normalized.Contains(TEXT(":")) || Parts.Contains(TEXT("..")))
+    {
+        Send(Client, FString::Printf(TEXT("ERR report path must be relative to Saved/ABV without '..': %s"), *CsvName));
+        return;
+    }
+
+    const FString ReportDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("ABV"));
+    const FString CsvPath = ReportDir / Normalized;
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(CsvPath), true);
+
+    FAssetBatchValidatorModule& Mod =
+        FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
+
+    if (Mod.ExportReportCSV(Client.LastResults, CsvPath))
+    {
+        Send(Client, FString::Printf(TEXT("OK report %d rows -> %s"), Client.LastResults.Num(), *CsvPath));
+    }
+    else
+    {
+        Send(Client, FString::Printf(TEXT("ERR cannot write %s"), *CsvPath));
+    }
+}
+
+void FABVDaemon::HandleStats(FClient& Client)
+{
+    Send(Client, FString::Printf(TEXT("OK %d requests, %d clients, %d warm results, %d hits, %d misses"),
+        NumRequests, Clients.Num(), WarmResults.Num(), NumWarmHits, NumWarmMisses));
+}
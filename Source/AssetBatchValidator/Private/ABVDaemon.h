@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IO/IoHash.h"
+#include "AssetRegistry/AssetData.h"
+#include "ABVTypes.h"
+
+#define ABV_WITH_DAEMON (PLATFORM_UNIX || PLATFORM_MAC)
+
+/**
+ * Resident validator serving requests over a local Unix socket, so CI pre-submits skip engine and registry startup.
+ * One request per line, fields separated by tabs; every response ends with a line starting with "OK " or "ERR ".
+ * Data lines before it always start with a tag of their own, so they can never be mistaken for the terminator:
+ *
+ *   validate <file|package>...     result rows: ROW\t<OK|Warning|Error>\t<ObjectPath>\t<W>x<H>\t<Message>
+ *   validate-root <path>           same, for every texture under a content path
+ *   delta <file>...                rescans changed files in the asset registry
+ *   fix <object path>...           FIXED\t<ObjectPath> per texture; applies FixTextures and saves the packages
+ *   report <csv name>              writes this client's last results as CSV under <Project>/Saved/ABV (relative, no '..');
+ *                                  the reply carries the full path
+ *   stats | shutdown
+ *
+ * Requests still buffered when a client half-closes are answered before the connection is closed.
+ * A request line longer than 1 MB gets "ERR request too long" and the connection is closed.
+ *
+ * Clients are multiplexed with poll() on the game thread (UObject work stays on one thread); results are kept
+ * warm in memory keyed by package saved-hash, so unchanged textures are answered without evaluation.
+ * Textures loaded only to answer a request are released (RF_Standalone cleared, one GC pass, see
+ * FABVMemoryTracker::ReleaseScanLoads) by the end of the request; textures that were already loaded stay.
+ * The socket file is created with mode 0600, so only the user running the daemon can connect.
+ */
+class FABVDaemon
+{
+public:
+    FABVDaemon(const FString& InSocketPath, const FABVRuleSettings& InRules);
+    ~FABVDaemon();
+
+    static FString GetDefaultSocketPath();
+
+    bool Start();
+    // Serves until a client sends "shutdown" or the engine is asked to exit
+    void Run();
+
+private:
+    struct FClient
+    {
+        int32 Fd = -1;
+        TArray<ANSICHAR> InBuffer;
+        TArray<ANSICHAR> OutBuffer;
+        TArray<FABVTextureIssue> LastResults;
+        bool bClosing = false;   // no more reads; closed once OutBuffer is flushed
+    };
+
+    struct FWarmResult
+    {
+        FIoHash PackageHash;
+        FABVTextureIssue Issue;
+    };
+
+    void HandleLine(FClient& Client, const FString& Line);
+    void HandleValidate(FClient& Client, const TArray<FString>& Args);
+    void HandleValidateRoot(FClient& Client, const FString& RootPath);
+    void HandleDelta(FClient& Client, const TArray<FString>& Files);
+    void HandleFix(FClient& Client, const TArray<FString>& ObjectPaths);
+    void HandleReport(FClient& Client, const FString& CsvName);
+    void HandleStats(FClient& Client);
+
+    // Validates through the warm cache: hits are copied, misses go to ValidateAssets and are remembered
+    void ValidateWarm(const TArray<FAssetData>& Assets, TArray<FABVTextureIssue>& OutIssues);
+    void SendResults(FClient& Client, const TArray<FABVTextureIssue>& Issues, double StartTime);
+    static void Send(FClient& Client, const FString& Line);
+
+    void AcceptClients();
+    bool ReadClient(FClient& Client);
+    bool FlushClient(FClient& Client);
+    void CloseClient(FClient& Client);
+
+    FString SocketPath;
+    FABVRuleSettings Rules;
+    int32 ListenFd = -1;
+    bool bShutdownRequested = false;
+
+    TArray<TUniquePtr<FClient>> Clients;
+    TMap<FString, FWarmResult> WarmResults;   // object path -> last result
+
+    int32 NumRequests = 0;
+    int32 NumWarmHits = 0;
+    int32 NumWarmMisses = 0;
+};
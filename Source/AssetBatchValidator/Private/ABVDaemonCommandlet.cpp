@@ -0,0 +1,52 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ABVDaemonCommandlet.h"
+
+#include "AssetBatchValidator.h"
+#include "ABVDaemon.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/Parse.h"
+#include "Modules/ModuleManager.h"
+
+UABVDaemonCommandlet::UABVDaemonCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UABVDaemonCommandlet::Main(const FString& Params)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    FAssetBatchValidatorModule& Mod =
+        FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+    FABVRuleSettings Rules;
+    FParse::Value(*Params, TEXT("MaxSize="), Rules.MaxTextureSize);
+    Rules.bCheckPowerOfTwo = !FParse::Param(*Params, TEXT("NoPOT"));
+    if (FParse::Param(*Params, TEXT("Profiles")))
+    {
+        Rules.PlatformProfiles = Mod.GetPlatformProfiles();
+    }
+
+    FString SocketPath = FABVDaemon::GetDefaultSocketPath();
+    FParse::Value(*Params, TEXT("Socket="), SocketPath);
+
+    // 启动时付一次全量 registry 的代价，之后每个请求只处理增量
+    AssetRegistry.SearchAllAssets(/*bSynchronousSearch=*/true);
+    UE_LOG(LogTemp, Display, TEXT("ABV Daemon: asset registry ready in %.1f s"), FPlatformTime::Seconds() - StartTime);
+
+    FABVDaemon Daemon(SocketPath, Rules);
+    if (!Daemon.Start())
+    {
+        return 2;
+    }
+    Daemon.Run();
+
+    UE_LOG(LogTemp, Display, TEXT("ABV Daemon: shut down after %.1f s"), FPlatformTime::Seconds() - StartTime);
+    return 0;
+}
@@ -0,0 +1,26 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ABVDaemonCommandlet.generated.h"
+
+/**
+ * Keeps a headless validator resident and serves requests over a Unix socket (see FABVDaemon for the protocol).
+ *
+ *   UnrealEditor-Cmd <Project>.uproject -run=ABVDaemon [-Socket=<path>] [-MaxSize=2048] [-NoPOT] [-Profiles]
+ *
+ * The asset registry is searched once at startup; clients push changes with "delta" instead of restarting.
+ * Example client: printf 'validate\tContent/Textures/T_Rock_N.uasset\n' | nc -U Saved/ABV/daemon.sock
+ */
+UCLASS()
+class UABVDaemonCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UABVDaemonCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
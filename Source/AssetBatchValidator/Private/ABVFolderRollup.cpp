@@ -0,0 +1,138 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ABVFolderRollup.h"
+
+#include "Misc/PackageName.h"
+
+// 错误多的文件夹排前面，其次警告，最后按名字
+static void ABV_SortNodes(TArray<TSharedPtr<FABVFolderNode>>& Nodes)
+{
+    Nodes.Sort([](const TSharedPtr<FABVFolderNode>& A, const TSharedPtr<FABVFolderNode>& B)
+    {
+        const int32 ErrA = A->SeverityCounts[static_cast<int32>(EABVIssueSeverity::Error)];
+        const int32 ErrB = B->SeverityCounts[static_cast<int32>(EABVIssueSeverity::Error)];
+        if (ErrA != ErrB) return ErrA > ErrB;
+
+        const int32 WarnA = A->SeverityCounts[static_cast<int32>(EABVIssueSeverity::Warning)];
+        const int32 WarnB = B->SeverityCounts[static_cast<int32>(EABVIssueSeverity::Warning)];
+        if (WarnA != WarnB) return WarnA > WarnB;
+
+        return A->Name < B->Name;
+    });
+}
+
+const TArray<TSharedPtr<FABVFolderNode>>& FABVFolderNode::GetSortedChildren()
+{
+    if (bChildrenDirty)
+    {
+        Children.GenerateValueArray(SortedChildren);
+        ABV_SortNodes(SortedChildren);
+        bChildrenDirty = false;
+    }
+    return SortedChildren;
+}
+
+void FABVFolderRollup::Reset()
+{
+    RootMap.Reset();
+    Roots.Reset();
+    bRootsDirty = true;
+}
+
+void FABVFolderRollup::Add(const FABVTextureIssue& Issue)
+{
+    Apply(Issue, +1);
+}
+
+void FABVFolderRollup::Remove(const FABVTextureIssue& Issue)
+{
+    Apply(Issue, -1);
+}
+
+TArray<TSharedPtr<FABVFolderNode>>& FABVFolderRollup::GetRoots()
+{
+    if (bRootsDirty)
+    {
+        RootMap.GenerateValueArray(Roots);
+        ABV_SortNodes(Roots);
+        bRootsDirty = false;
+    }
+    return Roots;
+}
+
+void FABVFolderRollup::Apply(const FABVTextureIssue& Issue, int32 Sign)
+{
+    // "/Game/A/B/T_X.T_X" -> ["Game", "A", "B"]
+    const FString PackagePath = FPackageName::GetLongPackagePath(FPackageName::ObjectPathToPackageName(Issue.AssetPath));
+    TArray<FString> Parts;
+    PackagePath.ParseIntoArray(Parts, TEXT("/"));
+    if (Parts.Num() == 0) return;
+
+    const int32 Sev = static_cast<int32>(Issue.Severity);
+    const int32 Kind = static_cast<int32>(Issue.Kind);
+    const int64 Bytes = ABV_EstimateTextureBytes(Issue.Width, Issue.Height, Issue.Kind);
+
+    // 先解析出整条路径；Remove 遇到缺失节点说明这条结果没加过，任何计数都不动
+    TArray<FABVFolderNode*, TInlineAllocator<16>> NodePath;
+    TMap<FString, TSharedPtr<FABVFolderNode>>* Level = &RootMap;
+    FABVFolderNode* Parent = nullptr;
+    FString FullPath;
+
+    for (const FString& Part : Parts)
+    {
+        FullPath += TEXT("/") + Part;
+
+        TSharedPtr<FABVFolderNode>* Found = Level->Find(Part);
+        if (!Found)
+        {
+            if (Sign < 0) return;
+
+            TSharedPtr<FABVFolderNode> NewNode = MakeShared<FABVFolderNode>();
+            NewNode->Name = Part;
+            NewNode->FullPath = FullPath;
+            NewNode->Parent = Parent;
+            Found = &Level->Add(Part, NewNode);
+
+            if (Parent) Parent->bChildrenDirty = true;
+            else bRootsDirty = true;
+        }
+
+        Parent = Found->Get();
+        NodePath.Add(Parent);
+        Level = &Parent->Children;
+    }
+
+    for (FABVFolderNode* Node : NodePath)
+    {
+        Node->NumAssets += Sign;
+        Node->SeverityCounts[Sev] += Sign;
+        Node->KindCounts[Kind] += Sign;
+        Node->EstimatedBytes += Sign * Bytes;
+
+        // 计数变了，父节点的排序也可能变
+        if (Node->Parent) Node->Parent->bChildrenDirty = true;
+        else bRootsDirty = true;
+    }
+
+    // Remove 后清掉空节点（自底向上）
+    if (Sign < 0)
+    {
+        FABVFolderNode* Node = Parent;
+        while (Node && Node->NumAssets <= 0)
+        {
+            FABVFolderNode* Up = Node->Parent;
+            const FString Key = Node->Name;
+            if (Up)
+            {
+                Up->Children.Remove(Key);
+                Up->bChildrenDirty = true;
+            }
+            else
+            {
+                RootMap.Remove(Key);
+                bRootsDirty = true;
+            }
+            Node = Up;
+        }
+    }
+}
@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ABVTypes.h"
+
+// One folder of the rollup tree; counts include everything below it
+struct FABVFolderNode
+{
+    FString Name;
+    FString FullPath;   // "/Game/Characters/Hero"
+    FABVFolderNode* Parent = nullptr;
+
+    int32 NumAssets = 0;
+    int32 SeverityCounts[3] = {};   // indexed by EABVIssueSeverity
+    int32 KindCounts[5] = {};       // indexed by EABVTextureKind
+    int64 EstimatedBytes = 0;
+
+    TMap<FString, TSharedPtr<FABVFolderNode>> Children;
+
+    // Sorted child list for the tree view, rebuilt only when requested after a change
+    const TArray<TSharedPtr<FABVFolderNode>>& GetSortedChildren();
+
+private:
+    friend class FABVFolderRollup;
+    TArray<TSharedPtr<FABVFolderNode>> SortedChildren;
+    bool bChildrenDirty = true;
+};
+
+/**
+ * Folder prefix tree over validation results. Add / Remove touch only the nodes on the asset's
+ * folder path (O(depth)), so the tree can be kept up to date while results stream in.
+ */
+class FABVFolderRollup
+{
+public:
+    void Reset();
+    void Add(const FABVTextureIssue& Issue);
+    void Remove(const FABVTextureIssue& Issue);
+
+    TArray<TSharedPtr<FABVFolderNode>>& GetRoots();
+
+private:
+    void Apply(const FABVTextureIssue& Issue, int32 Sign);
+
+    TMap<FString, TSharedPtr<FABVFolderNode>> RootMap;
+    TArray<TSharedPtr<FABVFolderNode>> Roots;
+    bool bRootsDirty = true;
+};
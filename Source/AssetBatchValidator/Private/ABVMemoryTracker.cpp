@@ -0,0 +1,252 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ABVMemoryTracker.h"
+
+#include "HAL/PlatformMemory.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectHash.h"
+
+LLM_DEFINE_TAG(AssetBatchValidator);
+
+FABVMemoryTracker& FABVMemoryTracker::Get()
+{
+    static FABVMemoryTracker Instance;
+    return Instance;
+}
+
+// LLM 的线程本地计数要在 UpdateStatsPerFrame 时才汇总到标签总数；批边界上手动汇总，但限制频率
+static constexpr double ABV_LLMRefreshInterval = 0.05;
+// 两次 GC 之间至少间隔这么久，避免超预算时每批都跑完整 GC
+static constexpr double ABV_MinCollectInterval = 2.0;
+
+static const FName ABV_LLMTagName(TEXT("AssetBatchValidator"));
+
+bool FABVMemoryTracker::UsesLLMTag()
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+    return FLowLevelMemTracker::IsEnabled();
+#else
+    return false;
+#endif
+}
+
+uint64 FABVMemoryTracker::ReadUsedBytes(bool bRefresh)
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+    if (FLowLevelMemTracker::IsEnabled())
+    {
+        FLowLevelMemTracker& LLM = FLowLevelMemTracker::Get();
+        const double Now = FPlatformTime::Seconds();
+        if (bRefresh && Now - LastRefreshTime >= ABV_LLMRefreshInterval)
+        {
+            LLM.UpdateStatsPerFrame();
+            LastRefreshTime = Now;
+        }
+        return static_cast<uint64>(FMath::Max<int64>(0, LLM.GetTagAmountForTracker(ELLMTracker::Default, ABV_LLMTagName, ELLMTagSet::None)));
+    }
+#endif
+    return FPlatformMemory::GetStats().UsedPhysical;
+}
+
+FABVMemoryPhaseStats& FABVMemoryTracker::FindOrAddPhase(FName Phase)
+{
+    for (FABVMemoryPhaseStats& P : Phases)
+    {
+        if (P.Phase == Phase) return P;
+    }
+    FABVMemoryPhaseStats& P = Phases.AddDefaulted_GetRef();
+    P.Phase = Phase;
+    return P;
+}
+
+void FABVMemoryTracker::BeginPhase(FName Phase)
+{
+    FABVMemoryPhaseStats& P = FindOrAddPhase(Phase);
+    P.NumRuns++;
+    P.CurrentBytes = 0;
+
+    const uint64 Baseline = ReadUsedBytes(/*bRefresh=*/ActiveStack.Num() == 0);
+    if (ActiveStack.Num() == 0)
+    {
+        BudgetBaseline = Baseline;
+        LastUsedBytes = Baseline;
+        bReportedOverBudget = false;
+    }
+    ActiveStack.Emplace(Phase, Baseline);
+}
+
+void FABVMemoryTracker::EndPhase(FName Phase)
+{
+    Sample();
+
+    for (int32 i = ActiveStack.Num() - 1; i >= 0; --i)
+    {
+        if (ActiveStack[i].Key == Phase)
+        {
+            ActiveStack.RemoveAt(i);
+            break;
+        }
+    }
+}
+
+void FABVMemoryTracker::Sample()
+{
+    const uint64 Used = ReadUsedBytes(/*bRefresh=*/true);
+    LastUsedBytes = Used;
+    for (const TPair<FName, uint64>& Active : ActiveStack)
+    {
+        FABVMemoryPhaseStats& P = FindOrAddPhase(Active.Key);
+        P.CurrentBytes = Used > Active.Value ? Used - Active.Value : 0;
+        P.PeakBytes = FMath::Max(P.PeakBytes, P.CurrentBytes);
+    }
+}
+
+uint64 FABVMemoryTracker::GetBudgetUsage() const
+{
+    return LastUsedBytes > BudgetBaseline ? LastUsedBytes - BudgetBaseline : 0;
+}
+
+bool FABVMemoryTracker::IsOverBudget() const
+{
+    if (BudgetBytes == 0 || ActiveStack.Num() == 0) return false;
+
+    // 以最外层 phase 起点（或上次 GC 后的新基准）为准，用最近一次采样
+    return GetBudgetUsage() > BudgetBytes;
+}
+
+bool FABVMemoryTracker::CollectIfOverBudget()
+{
+    Sample();
+    if (!IsOverBudget())
+    {
+        return false;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    if (Now - LastCollectTime < ABV_MinCollectInterval)
+    {
+        return false;
+    }
+    LastCollectTime = Now;
+
+    const int32 NumFreed = ReleaseScanLoads();
+    Sample();
+
+    // 释放后仍超预算：如实报告，不挪基准，调用方继续缩小批大小
+    if (IsOverBudget() && !bReportedOverBudget)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ABV: Still %.1f MB over the memory budget after freeing %d objects loaded by the scan"),
+            (GetBudgetUsage() - BudgetBytes) / (1024.0 * 1024.0), NumFreed);
+        bReportedOverBudget = true;
+    }
+    return NumFreed > 0;
+}
+
+void FABVMemoryTracker::TrackScanLoad(UObject* Asset)
+{
+    if (Asset)
+    {
+        ScanLoads.Emplace(Asset);
+    }
+}
+
+int32 FABVMemoryTracker::ReleaseScanLoads(int32 MinLoads)
+{
+    if (ScanLoads.Num() == 0 || ScanLoads.Num() < MinLoads)
+    {
+        return 0;
+    }
+
+    // 编辑器 GC 保留所有 RF_Standalone 资源：只对扫描新加载、包未修改的贴图清掉它（整个包，和 UnloadPackages 一样）
+    TArray<TWeakObjectPtr<UObject>> Cleared;
+    for (const TWeakObjectPtr<UObject>& Weak : ScanLoads)
+    {
+        const UObject* Asset = Weak.Get();
+        const UPackage* Package = Asset ? Asset->GetPackage() : nullptr;
+        if (!Package || Package->IsDirty())
+        {
+            continue;
+        }
+        ForEachObjectWithPackage(Package, [&Cleared](UObject* Object)
+        {
+            if (Object->HasAnyFlags(RF_Standalone))
+            {
+                Object->ClearFlags(RF_Standalone);
+                Cleared.Emplace(Object);
+            }
+            return true;
+        });
+    }
+    ScanLoads.Reset();
+
+    if (Cleared.Num() == 0)
+    {
+        return 0;
+    }
+
+    // 编辑器里 KEEPFLAGS 仍保留用户加载的其他资源，上面清掉标记的对象不再受保护；编辑器外它本来就是 RF_NoFlags
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    LastCollectTime = FPlatformTime::Seconds();
+
+    // 还被别处引用的活下来，恢复标记，之后的修改不会因为缺 Standalone 被回收
+    int32 NumFreed = 0;
+    for (const TWeakObjectPtr<UObject>& Weak : Cleared)
+    {
+        if (UObject* Object = Weak.Get())
+        {
+            Object->SetFlags(RF_Standalone);
+        }
+        else
+        {
+            ++NumFreed;
+        }
+    }
+    return NumFreed;
+}
+
+int32 FABVMemoryTracker::AdaptBatchSize(int32 Current, int32 MinSize, int32 MaxSize)
+{
+    if (BudgetBytes == 0 || ActiveStack.Num() == 0)
+    {
+        Sample();
+        return MaxSize;
+    }
+
+    if (CollectIfOverBudget() || IsOverBudget())
+    {
+        return FMath::Max(MinSize, Current / 2);
+    }
+
+    if (GetBudgetUsage() < BudgetBytes / 2)
+    {
+        return FMath::Min(MaxSize, Current * 2);
+    }
+    return Current;
+}
+
+const FABVMemoryPhaseStats* FABVMemoryTracker::FindPhase(FName Phase) const
+{
+    return Phases.FindByPredicate([Phase](const FABVMemoryPhaseStats& P) { return P.Phase == Phase; });
+}
+
+FString FABVMemoryTracker::GetSummary() const
+{
+    FString Out;
+    for (const FABVMemoryPhaseStats& P : Phases)
+    {
+        if (!Out.IsEmpty()) Out += TEXT("  |  ");
+        Out += FString::Printf(TEXT("%s: peak %.1f MB, current %.1f MB"),
+            *P.Phase.ToString(), P.PeakBytes / (1024.0 * 1024.0), P.CurrentBytes / (1024.0 * 1024.0));
+    }
+    if (Out.IsEmpty())
+    {
+        return TEXT("No runs yet");
+    }
+    Out += UsesLLMTag() ? TEXT("  [LLM tag]") : TEXT("  [process, run with -llm for validator-only figures]");
+    if (BudgetBytes > 0)
+    {
+        Out += FString::Printf(TEXT("  (budget %.0f MB)"), BudgetBytes / (1024.0 * 1024.0));
+    }
+    return Out;
+}
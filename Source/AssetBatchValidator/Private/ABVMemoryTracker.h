@@ -0,0 +1,96 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "UObject/WeakObjectPtr.h"
+
+// All validator allocations are attributed to this tag in LLM reports (-llm, stat LLM, LLM csv)
+LLM_DECLARE_TAG(AssetBatchValidator);
+
+#define ABV_LLM_SCOPE() LLM_SCOPE_BYTAG(AssetBatchValidator)
+
+struct FABVMemoryPhaseStats
+{
+    FName Phase;
+    uint64 PeakBytes = 0;      // highest usage above the phase baseline, over all runs of the phase
+    uint64 CurrentBytes = 0;   // usage above baseline at the last sample
+    int32 NumRuns = 0;
+};
+
+/**
+ * Per-phase memory accounting for scan / fix runs, plus the budget the batch loops throttle against.
+ * Usage is the AssetBatchValidator LLM tag total when LLM is enabled (-llm), process used-physical otherwise,
+ * measured above the value at phase start and sampled at batch boundaries.
+ * Game-thread only.
+ */
+class FABVMemoryTracker
+{
+public:
+    static FABVMemoryTracker& Get();
+
+    void BeginPhase(FName Phase);
+    void EndPhase(FName Phase);
+    void Sample();
+
+    // 0 = unlimited. Read from [AssetBatchValidator] MemoryBudgetMB.
+    void SetBudgetBytes(uint64 InBudget) { BudgetBytes = InBudget; }
+    uint64 GetBudgetBytes() const { return BudgetBytes; }
+    bool IsOverBudget() const;
+
+    // Releases the tracked scan loads (see ReleaseScanLoads) when over budget. Returns true if that freed anything.
+    // At most one pass every couple of seconds. Memory that stays over budget is reported, never hidden by moving the baseline.
+    bool CollectIfOverBudget();
+
+    // Textures a scan loaded that were not in memory before. The caller checks that before loading (FAssetData::IsAssetLoaded).
+    void TrackScanLoad(UObject* Asset);
+    int32 GetNumScanLoads() const { return ScanLoads.Num(); }
+    /**
+     * Once at least MinLoads are tracked: clears RF_Standalone on the tracked loads whose package is still clean and runs
+     * one GC pass (the editor GC keeps every standalone asset otherwise). Objects something else still references survive
+     * and get RF_Standalone back. Returns the number of objects freed.
+     */
+    int32 ReleaseScanLoads(int32 MinLoads = 1);
+
+    // Scan loops hold at most this many newly loaded textures before releasing them
+    static constexpr int32 MaxScanLoads = 256;
+
+    /**
+     * Next batch size for a throttled loop: halves (and collects garbage once) while over budget,
+     * grows back towards MaxSize while below half of it.
+     */
+    int32 AdaptBatchSize(int32 Current, int32 MinSize, int32 MaxSize);
+
+    const TArray<FABVMemoryPhaseStats>& GetPhases() const { return Phases; }
+    const FABVMemoryPhaseStats* FindPhase(FName Phase) const;
+    FString GetSummary() const;
+
+    // True if figures come from the LLM tag rather than the whole process
+    static bool UsesLLMTag();
+
+private:
+    FABVMemoryPhaseStats& FindOrAddPhase(FName Phase);
+    // bRefresh folds pending per-thread LLM counts into the tag total first (rate-limited, see cpp)
+    uint64 ReadUsedBytes(bool bRefresh);
+    uint64 GetBudgetUsage() const;
+
+    TArray<FABVMemoryPhaseStats> Phases;
+    TArray<TPair<FName, uint64>> ActiveStack;   // phase, baseline
+    uint64 BudgetBytes = 0;
+    uint64 BudgetBaseline = 0;   // outermost phase baseline
+    uint64 LastUsedBytes = 0;    // at the last Sample()
+    double LastRefreshTime = 0.0;
+    double LastCollectTime = 0.0;
+    bool bReportedOverBudget = false;   // once per outermost phase
+    TArray<TWeakObjectPtr<UObject>> ScanLoads;
+};
+
+struct FABVScopedMemoryPhase
+{
+    explicit FABVScopedMemoryPhase(FName InPhase) : Phase(InPhase) { FABVMemoryTracker::Get().BeginPhase(Phase); }
+    ~FABVScopedMemoryPhase() { FABVMemoryTracker::Get().EndPhase(Phase); }
+
+private:
+    FName Phase;
+};
@@ -0,0 +1,223 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ABVOfflineScanner.h"
+
+#include "ABVTextureRules.h"
+#include "Async/MappedFileHandle.h"
+#include "ABVMemoryTracker.h"
+#include "ABVTaskExecutor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "UObject/PackageFileSummary.h"
+#include "UObject/ObjectVersion.h"
+
+#include <atomic>
+
+bool FABVOfflineScanner::ReadTextureFacts(const FString& Filename, const FString& LongPackageName, TArray<FABVTextureFacts>& OutFacts)
+{
+    OutFacts.Reset();
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    TUniquePtr<IMappedFileHandle> Handle(PlatformFile.OpenMapped(*Filename));
+    if (!Handle.IsValid())
+    {
+        return false;
+    }
+    TUniquePtr<IMappedFileRegion> Region(Handle->MapRegion(0, Handle->GetFileSize()));
+    if (!Region.IsValid())
+    {
+        return false;
+    }
+
+    FMemoryReaderView Ar(MakeArrayView(Region->GetMappedPtr(), static_cast<int32>(FMath::Min<int64>(Region->GetMappedSize(), MAX_int32))));
+
+    // 1) package summary
+    FPackageFileSummary Summary;
+    Ar << Summary;
+    if (Ar.IsError() || Summary.Tag != PACKAGE_FILE_TAG)
+    {
+        return false;
+    }
+    if ((Summary.GetPackageFlags() & PKG_FilterEditorOnly) != 0)
+    {
+        return false;   // cooked 包没有编辑器 tag
+    }
+    if (Summary.AssetRegistryDataOffset <= 0 || Summary.AssetRegistryDataOffset >= Ar.TotalSize())
+    {
+        return false;
+    }
+
+    // 2) asset registry tag block: [DependencyDataOffset] ObjectCount { ObjectPath ClassName TagCount { Key Value } }
+    Ar.SetUEVer(Summary.GetFileVersionUE());
+    Ar.Seek(Summary.AssetRegistryDataOffset);
+
+    if (Summary.GetFileVersionUE() >= VER_UE4_ASSETREGISTRY_DEPENDENCYFLAGS)
+    {
+        int64 DependencyDataOffset = 0;
+        Ar << DependencyDataOffset;
+    }
+
+    int32 ObjectCount = 0;
+    Ar << ObjectCount;
+    if (Ar.IsError() || ObjectCount < 0 || ObjectCount > 4096)
+    {
+        return false;
+    }
+
+    for (int32 ObjectIdx = 0; ObjectIdx < ObjectCount && !Ar.IsError(); ++ObjectIdx)
+    {
+        FString ObjectPath;
+        FString ClassName;
+        int32 TagCount = 0;
+        Ar << ObjectPath << ClassName << TagCount;
+        if (Ar.IsError() || TagCount < 0 || TagCount > 4096)
+        {
+            return false;
+        }
+
+        TMap<FName, FString> Tags;
+        Tags.Reserve(TagCount);
+        for (int32 TagIdx = 0; TagIdx < TagCount; ++TagIdx)
+        {
+            FString Key;
+            FString Value;
+            Ar << Key << Value;
+            Tags.Add(FName(*Key), MoveTemp(Value));
+        }
+
+        // UE5.1+ 写完整 class path，老包只写类名
+        const bool bIsTexture2D = (ClassName == TEXT("/Script/Engine.Texture2D")) || (ClassName == TEXT("Texture2D"));
+        if (!bIsTexture2D) continue;
+
+        // 旧格式 ObjectPath 可能带 package 前缀
+        const FString ObjectName = ObjectPath.Contains(TEXT("/")) ? FPackageName::ObjectPathToObjectName(ObjectPath) : ObjectPath;
+        const FString AssetPath = LongPackageName + TEXT(".") + ObjectName;
+
+        FABVTextureFacts Facts;
+        const bool bOk = ABV_GatherTextureFactsFromTags(AssetPath, [&Tags](FName Tag, FString& OutValue)
+        {
+            if (const FString* Found = Tags.Find(Tag))
+            {
+                OutValue = *Found;
+                return true;
+            }
+            return false;
+        }, Facts);
+
+        if (bOk)
+        {
+            OutFacts.Add(MoveTemp(Facts));
+        }
+    }
+
+    return !Ar.IsError();
+}
+
+bool FABVOfflineScanner::ScanDirectory(const FString& ContentDir, const FString& MountPoint, const FABVRuleSettings& Rules, TArray<FABVTextureIssue>& OutIssues, const FABVScanLimits& Limits)
+{
+    OutIssues.Reset();
+    const double StartTime = FPlatformTime::Seconds();
+
+    ABV_LLM_SCOPE();
+    FABVScopedMemoryPhase MemoryPhase(TEXT("OfflineScan"));
+
+    const FString Root = FPaths::ConvertRelativePathToFull(ContentDir);
+    TArray<FString> Files;
+    IFileManager::Get().FindFilesRecursive(Files, *Root, *(FString(TEXT("*")) + FPackageName::GetAssetPackageExtension()), /*Files=*/true, /*Directories=*/false);
+
+    // 每个文件独立读取/评估，所有核心并行（工作窃取，包大小差异大）；结果按文件下标存放，输出顺序与单线程一致
+    TArray<TArray<FABVTextureIssue>> PerFile;
+    PerFile.SetNum(Files.Num());
+
+    // fail-fast：任一 worker 达到上限后，其余未开始的文件直接跳过
+    std::atomic<int32> NumErrors{ 0 };
+    std::atomic<bool> bStopped{ false };
+
+    ABV_ParallelForAdaptive(Files.Num(), [&](int32 Index)
+    {
+        if (bStopped.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        if (Limits.TimeBudgetSeconds > 0.0 && FPlatformTime::Seconds() - StartTime >= Limits.TimeBudgetSeconds)
+        {
+            bStopped = true;
+            return;
+        }
+
+        FString Relative = Files[Index];
+        FPaths::MakePathRelativeTo(Relative, *(Root + TEXT("/")));
+        const FString LongPackageName = MountPoint / FPaths::ChangeExtension(Relative, TEXT(""));
+
+        TArray<FABVTextureFacts> FactsList;
+        if (!ReadTextureFacts(Files[Index], LongPackageName, FactsList))
+        {
+            return;
+        }
+
+        for (const FABVTextureFacts& Facts : FactsList)
+        {
+            FABVTextureIssue Issue;
+            ABV_EvaluateTextureFacts(Facts, Rules, Issue);
+            if (Issue.Severity == EABVIssueSeverity::Error && Limits.MaxErrors > 0 && NumErrors.fetch_add(1) + 1 >= Limits.MaxErrors)
+            {
+                bStopped = true;
+            }
+            PerFile[Index].Add(MoveTemp(Issue));
+        }
+    });
+
+    for (TArray<FABVTextureIssue>& FileIssues : PerFile)
+    {
+        OutIssues.Append(MoveTemp(FileIssues));
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("=== ABV: Offline scan of %s: %d packages, %d textures in %.1f ms ==="),
+        *Root, Files.Num(), OutIssues.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+    if (bStopped)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ABV: Offline scan stopped early (%s), result is partial"),
+            (Limits.MaxErrors > 0 && NumErrors.load() >= Limits.MaxErrors) ? TEXT("error limit") : TEXT("time budget"));
+        return false;
+    }
+    return true;
+}
+
+int32 FABVOfflineScanner::CompareWithEditor(const TArray<FABVTextureIssue>& EditorIssues, const TArray<FABVTextureIssue>& OfflineIssues, TArray<FString>& OutMismatches)
+{
+    OutMismatches.Reset();
+
+    TMap<FString, const FABVTextureIssue*> OfflineByPath;
+    for (const FABVTextureIssue& I : OfflineIssues)
+    {
+        OfflineByPath.Add(I.AssetPath, &I);
+    }
+
+    for (const FABVTextureIssue& E : EditorIssues)
+    {
+        const FABVTextureIssue* const* Found = OfflineByPath.Find(E.AssetPath);
+        if (!Found)
+        {
+            OutMismatches.Add(FString::Printf(TEXT("%s missing from offline scan"), *E.AssetPath));
+            continue;
+        }
+
+        const FABVTextureIssue& O = **Found;
+        if (O.Severity != E.Severity || O.Message != E.Message || O.Width != E.Width || O.Height != E.Height)
+        {
+            OutMismatches.Add(FString::Printf(TEXT("%s editor=[%dx%d %s] offline=[%dx%d %s]"),
+                *E.AssetPath, E.Width, E.Height, *E.Message, O.Width, O.Height, *O.Message));
+        }
+        OfflineByPath.Remove(E.AssetPath);
+    }
+
+    for (const TPair<FString, const FABVTextureIssue*>& Extra : OfflineByPath)
+    {
+        OutMismatches.Add(FString::Printf(TEXT("%s only in offline scan"), *Extra.Key));
+    }
+    return OutMismatches.Num();
+}
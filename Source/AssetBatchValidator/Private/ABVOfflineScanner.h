@@ -0,0 +1,31 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ABVTypes.h"
+
+struct FABVTextureFacts;
+
+/**
+ * Validates textures straight from .uasset files on disk, without the asset registry or loading packages.
+ *
+ * Each package is memory-mapped; only the package summary and the asset registry tag block it points to
+ * are read (bulk data pages are never touched). Texture facts come from the searchable tags the editor
+ * writes on save, so the same ABV_EvaluateTextureFacts rules apply as in ValidateTextures.
+ */
+class FABVOfflineScanner
+{
+public:
+    // ContentDir is scanned recursively; MountPoint is its long package root (e.g. "/Game/").
+    // Limits.MaxErrors / TimeBudgetSeconds stop the scan early (returns false, OutIssues holds the files read so far).
+    // There is no registry to predict impact from, so Limits.bImpactOrder is ignored.
+    static bool ScanDirectory(const FString& ContentDir, const FString& MountPoint, const FABVRuleSettings& Rules, TArray<FABVTextureIssue>& OutIssues, const FABVScanLimits& Limits = FABVScanLimits());
+
+    // Texture facts for every UTexture2D in one package file
+    static bool ReadTextureFacts(const FString& Filename, const FString& LongPackageName, TArray<FABVTextureFacts>& OutFacts);
+
+    // Row-by-row comparison (by AssetPath: severity, size, message) with the in-editor result for the same content.
+    // One line per mismatch, including rows that only one side has; returns the number of mismatches.
+    static int32 CompareWithEditor(const TArray<FABVTextureIssue>& EditorIssues, const TArray<FABVTextureIssue>& OfflineIssues, TArray<FString>& OutMismatches);
+};
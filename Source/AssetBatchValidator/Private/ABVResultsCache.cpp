@@ -0,0 +1,239 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ABVResultsCache.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/Package.h"
+
+static constexpr uint32 ABV_CacheMagic = 0x43564241; // "ABVC"
+static constexpr uint32 ABV_CacheVersion = 3;
+
+FIoHash ABV_GetPackageSavedHash(const FString& ObjectPath)
+{
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+    const FName PackageName(*FPackageName::ObjectPathToPackageName(ObjectPath));
+    const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+    return PackageData.IsSet() ? PackageData->GetPackageSavedHash() : FIoHash::Zero;
+}
+
+void ABV_SerializeIssue(FArchive& Ar, FABVTextureIssue& I, FIoHash& Hash)
+{
+    uint8 Kind = static_cast<uint8>(I.Kind);
+    uint8 Sev = static_cast<uint8>(I.Severity);
+    bool bCanFix = I.bCanFix;
+
+    Ar << I.AssetPath;
+    Ar << I.Width;
+    Ar << I.Height;
+    Ar << Kind;
+    Ar << Sev;
+    Ar << I.Message;
+    Ar << bCanFix;
+    Ar << Hash;
+
+    int32 NumPlatforms = I.PlatformResults.Num();
+    Ar << NumPlatforms;
+    if (Ar.IsLoading())
+    {
+        I.PlatformResults.SetNum(FMath::Max(0, NumPlatforms));
+    }
+    for (FABVPlatformResult& PR : I.PlatformResults)
+    {
+        uint8 PlatformSev = static_cast<uint8>(PR.Severity);
+        Ar << PR.Platform << PlatformSev << PR.Message;
+        PR.Severity = static_cast<EABVIssueSeverity>(PlatformSev);
+    }
+
+    if (Ar.IsLoading())
+    {
+        I.Kind = static_cast<EABVTextureKind>(Kind);
+        I.Severity = static_cast<EABVIssueSeverity>(Sev);
+        I.bCanFix = bCanFix;
+    }
+}
+
+FString FABVResultsCache::GetDefaultPath()
+{
+    return FPaths::ProjectSavedDir() / TEXT("ABV") / TEXT("ResultsCache.bin");
+}
+
+void FABVResultsCache::CapturePackageHashes()
+{
+    PackageHashes.SetNum(Issues.Num());
+    for (int32 i = 0; i < Issues.Num(); ++i)
+    {
+        // 有未保存修改（修复 / 重新导入后）的包：结果描述的是内存里的状态，不是磁盘上的；
+        // 还没重新验证完的过期行：结果本身就是旧的。两者都记零哈希，下次启动时重新验证
+        const FString PackageName = FPackageName::ObjectPathToPackageName(Issues[i].AssetPath);
+        const UPackage* LoadedPackage = FindObject<UPackage>(nullptr, *PackageName);
+        PackageHashes[i] = (Issues[i].bStale || (LoadedPackage && LoadedPackage->IsDirty()))
+            ? FIoHash::Zero
+            : ABV_GetPackageSavedHash(Issues[i].AssetPath);
+    }
+}
+
+bool FABVResultsCache::Save(const FString& FilePath) const
+{
+    check(PackageHashes.Num() == Issues.Num());
+
+    TArray<uint8> Bytes;
+    FMemoryWriter Ar(Bytes);
+
+    uint32 Magic = ABV_CacheMagic;
+    uint32 Version = ABV_CacheVersion;
+    FString Root = RootPath.ToString();
+    FIoHash Fingerprint = RulesFingerprint;
+    int32 Count = Issues.Num();
+    Ar << Magic << Version << Root << Fingerprint << Count;
+
+    for (int32 i = 0; i < Count; ++i)
+    {
+        FABVTextureIssue I = Issues[i];
+        FIoHash Hash = PackageHashes[i];
+        ABV_SerializeIssue(Ar, I, Hash);
+    }
+
+    // 先写临时文件再改名，避免读到写了一半的缓存
+    const FString TempPath = FilePath + TEXT(".tmp");
+    if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ABV: Failed to write results cache %s"), *TempPath);
+        return false;
+    }
+    return IFileManager::Get().Move(*FilePath, *TempPath, /*bReplace=*/true);
+}
+
+FABVResultsCache::FABVResultsCache() = default;
+
+FABVResultsCache::~FABVResultsCache() = default;
+
+void FABVResultsCache::CloseMapping()
+{
+    MappedRegion.Reset();
+    MappedHandle.Reset();
+    ReadOffset = 0;
+}
+
+bool FABVResultsCache::Open(const FString& FilePath)
+{
+    Issues.Reset();
+    PackageHashes.Reset();
+    NumRows = 0;
+    CloseMapping();
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    MappedHandle.Reset(PlatformFile.OpenMapped(*FilePath));
+    if (!MappedHandle.IsValid())
+    {
+        return false;
+    }
+
+    MappedRegion.Reset(MappedHandle->MapRegion(0, MappedHandle->GetFileSize()));
+    if (!MappedRegion.IsValid())
+    {
+        CloseMapping();
+        return false;
+    }
+
+    TArrayView<const uint8> View(MappedRegion->GetMappedPtr(), static_cast<int32>(MappedRegion->GetMappedSize()));
+    FMemoryReaderView Ar(View);
+
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    FString Root;
+    int32 Count = 0;
+    Ar << Magic << Version;
+    if (Magic != ABV_CacheMagic || Version != ABV_CacheVersion)
+    {
+        UE_LOG(LogTemp, Display, TEXT("ABV: Ignoring results cache with unknown format: %s"), *FilePath);
+        CloseMapping();
+        return false;
+    }
+    Ar << Root << RulesFingerprint << Count;
+    if (Ar.IsError() || Count < 0)
+    {
+        CloseMapping();
+        return false;
+    }
+
+    RootPath = FName(*Root);
+    NumRows = Count;
+    ReadOffset = Ar.Tell();
+    Issues.Reserve(Count);
+    PackageHashes.Reserve(Count);
+    if (Count == 0)
+    {
+        CloseMapping();
+    }
+    return true;
+}
+
+int32 FABVResultsCache::ReadRows(int32 MaxRows)
+{
+    if (!MappedRegion.IsValid() || IsFullyRead())
+    {
+        return 0;
+    }
+
+    // 直接在映射内存上解码，不额外拷贝整个文件
+    TArrayView<const uint8> View(MappedRegion->GetMappedPtr(), static_cast<int32>(MappedRegion->GetMappedSize()));
+    FMemoryReaderView Ar(View);
+    Ar.Seek(ReadOffset);
+
+    const int32 Begin = Issues.Num();
+    const int32 End = static_cast<int32>(FMath::Min<int64>(static_cast<int64>(Begin) + FMath::Max(MaxRows, 0), NumRows));
+    for (int32 i = Begin; i < End && !Ar.IsError(); ++i)
+    {
+        ABV_SerializeIssue(Ar, Issues.AddDefaulted_GetRef(), PackageHashes.AddDefaulted_GetRef());
+    }
+
+    if (Ar.IsError())
+    {
+        Issues.Reset();
+        PackageHashes.Reset();
+        NumRows = 0;
+        CloseMapping();
+        return INDEX_NONE;
+    }
+
+    ReadOffset = Ar.Tell();
+    if (IsFullyRead())
+    {
+        CloseMapping();
+    }
+    return End - Begin;
+}
+
+bool FABVResultsCache::Load(const FString& FilePath)
+{
+    return Open(FilePath) && ReadRows(MAX_int32) != INDEX_NONE;
+}
+
+int32 FABVResultsCache::MarkStale(const FIoHash& CurrentRulesFingerprint)
+{
+    // 规则变了：所有行都是按旧规则算的，不能和新结果混在一张表里
+    const bool bRulesChanged = RulesFingerprint != CurrentRulesFingerprint;
+    if (bRulesChanged)
+    {
+        UE_LOG(LogTemp, Display, TEXT("ABV: Rule settings changed since the results cache was written, revalidating all %d rows"), Issues.Num());
+    }
+
+    int32 NumStale = 0;
+    for (int32 i = 0; i < Issues.Num(); ++i)
+    {
+        const FIoHash Current = ABV_GetPackageSavedHash(Issues[i].AssetPath);
+        Issues[i].bStale = bRulesChanged || Current.IsZero() || Current != PackageHashes[i];
+        NumStale += Issues[i].bStale ? 1 : 0;
+    }
+    return NumStale;
+}
@@ -0,0 +1,63 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IO/IoHash.h"
+#include "ABVTypes.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * On-disk snapshot of the last full scan, so the panel can show results right after an editor restart.
+ * Every row carries the package saved-hash it was validated against; rows whose package hash no longer
+ * matches the asset registry are reported as stale. The header stores the rules fingerprint of the scan,
+ * so a cache written under different rule settings is stale as a whole.
+ */
+struct FABVResultsCache
+{
+    FName RootPath;
+    FIoHash RulesFingerprint;        // FABVSharedCache::ComputeRulesFingerprint of the rules the rows were validated with
+    TArray<FABVTextureIssue> Issues;
+    TArray<FIoHash> PackageHashes;   // parallel to Issues
+
+    static FString GetDefaultPath();
+
+    // Fills PackageHashes from the registry (zero hash for unknown packages, packages with unsaved changes
+    // and rows still marked bStale, so they are revalidated after the next load)
+    void CapturePackageHashes();
+
+    bool Save(const FString& FilePath) const;
+    // Memory-maps FilePath and reads the header only; rows are decoded on demand by ReadRows.
+    // Does not touch the asset registry.
+    bool Open(const FString& FilePath);
+    // Decodes up to MaxRows more rows from the mapping into Issues / PackageHashes, unmaps once all are read.
+    // Returns the number decoded, INDEX_NONE if the file is corrupt (Issues is then reset).
+    int32 ReadRows(int32 MaxRows);
+    bool IsFullyRead() const { return Issues.Num() >= NumRows; }
+    int32 GetNumRows() const { return NumRows; }
+    // Open + ReadRows(all)
+    bool Load(const FString& FilePath);
+
+    // Marks Issues[i].bStale where the registry hash differs from the cached one, or every row if the cache
+    // was written under other rules than CurrentRulesFingerprint. Returns stale count.
+    int32 MarkStale(const FIoHash& CurrentRulesFingerprint);
+
+    FABVResultsCache();
+    ~FABVResultsCache();
+
+private:
+    void CloseMapping();
+
+    TUniquePtr<IMappedFileHandle> MappedHandle;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+    int64 ReadOffset = 0;
+    int32 NumRows = 0;
+};
+
+// Package saved-hash from the asset registry (no package load); zero if unknown
+FIoHash ABV_GetPackageSavedHash(const FString& ObjectPath);
+
+// Row serializer shared by the results cache and the shared team cache
+void ABV_SerializeIssue(FArchive& Ar, FABVTextureIssue& Issue, FIoHash& PackageHash);
@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ABVScheduler.h"
+
+#include "ABVTextureRules.h"
+#include "AssetRegistry/AssetData.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+
+FABVImpactKey ABV_EstimateImpact(const FAssetData& AD, const FABVRuleSettings& Rules, bool bWithTimestamp)
+{
+    FABVImpactKey Key;
+
+    // 用 registry tag 预判结果：和真正验证同一套规则，只是数据来自 tag
+    FABVTextureFacts Facts;
+    const bool bHasFacts = ABV_GatherTextureFactsFromTags(AD.GetObjectPathString(), [&AD](FName Tag, FString& OutValue)
+    {
+        return AD.GetTagValue(Tag, OutValue);
+    }, Facts);
+
+    if (bHasFacts)
+    {
+        FABVTextureIssue Predicted;
+        ABV_EvaluateTextureFacts(Facts, Rules, Predicted);
+        Key.PredictedSeverity = static_cast<uint8>(Predicted.Severity);
+        Key.Pixels = static_cast<int64>(Facts.Width) * Facts.Height;
+    }
+    else
+    {
+        // 没有 tag（老包）：排在同级最前，避免漏掉
+        Key.PredictedSeverity = static_cast<uint8>(EABVIssueSeverity::Warning);
+        Key.Pixels = MAX_int64;
+    }
+
+    if (bWithTimestamp)
+    {
+        FString Filename;
+        if (FPackageName::TryConvertLongPackageNameToFilename(AD.PackageName.ToString(), Filename, FPackageName::GetAssetPackageExtension()))
+        {
+            Key.ModifiedTicks = IFileManager::Get().GetTimeStamp(*Filename).GetTicks();
+        }
+    }
+    return Key;
+}
+
+void ABV_SortAssetsByImpact(TArray<FAssetData>& Assets, const FABVRuleSettings& Rules)
+{
+    const int32 Num = Assets.Num();
+
+    TArray<FABVImpactKey> Keys;
+    Keys.SetNum(Num);
+    ParallelFor(Num, [&Assets, &Keys, &Rules](int32 Index)
+    {
+        Keys[Index] = ABV_EstimateImpact(Assets[Index], Rules, /*bWithTimestamp=*/true);
+    });
+
+    TArray<int32> Order;
+    Order.SetNumUninitialized(Num);
+    for (int32 i = 0; i < Num; ++i) Order[i] = i;
+    Order.StableSort([&Keys](int32 A, int32 B) { return Keys[A] > Keys[B]; });
+
+    TArray<FAssetData> Sorted;
+    Sorted.Reserve(Num);
+    for (int32 Index : Order)
+    {
+        Sorted.Add(MoveTemp(Assets[Index]));
+    }
+    Assets = MoveTemp(Sorted);
+}
@@ -0,0 +1,30 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ABVTypes.h"
+
+struct FAssetData;
+
+// Expected impact of validating one asset, estimated from registry tags only (no load).
+// Ordered by predicted severity, then source pixel count, then package modification time.
+struct FABVImpactKey
+{
+    uint8 PredictedSeverity = 0;
+    int64 Pixels = 0;
+    int64 ModifiedTicks = 0;
+
+    bool operator>(const FABVImpactKey& Other) const
+    {
+        if (PredictedSeverity != Other.PredictedSeverity) return PredictedSeverity > Other.PredictedSeverity;
+        if (Pixels != Other.Pixels) return Pixels > Other.Pixels;
+        return ModifiedTicks > Other.ModifiedTicks;
+    }
+};
+
+// bWithTimestamp stats the package file; leave it off on the game thread for large batches
+FABVImpactKey ABV_EstimateImpact(const FAssetData& AD, const FABVRuleSettings& Rules, bool bWithTimestamp);
+
+// Sorts Assets worst-first. Keys (including file timestamps) are computed in parallel.
+void ABV_SortAssetsByImpact(TArray<FAssetData>& Assets, const FABVRuleSettings& Rules);
@@ -0,0 +1,230 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ABVSharedCache.h"
+
+#include "ABVResultsCache.h"
+#include "Hash/Blake3.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+static constexpr uint32 ABV_SharedCacheMagic = 0x53564241; // "ABVS"
+static constexpr uint32 ABV_SharedCacheVersion = 1;
+
+// 规则逻辑改变时递增，让旧结果全部失效
+static constexpr uint32 ABV_RulesVersion = 1;
+
+// 遍历共享目录很慢（尤其是网络盘），最多每 10 分钟一次
+static constexpr double ABV_SharedCacheEvictInterval = 600.0;
+
+FABVSharedCache::FABVSharedCache(const FString& InDirectory, int64 InMaxBytes)
+    : Directory(InDirectory)
+    , MaxBytes(InMaxBytes)
+    , LastEvictTime(FPlatformTime::Seconds())
+{
+}
+
+FABVSharedCache::~FABVSharedCache()
+{
+    EvictTask.Wait();
+}
+
+FIoHash FABVSharedCache::ComputeRulesFingerprint(const FABVRuleSettings& Rules)
+{
+    TArray<uint8> Bytes;
+    FMemoryWriter Ar(Bytes);
+
+    uint32 Version = ABV_RulesVersion;
+    int32 MaxTextureSize = Rules.MaxTextureSize;
+    bool bCheckPowerOfTwo = Rules.bCheckPowerOfTwo;
+    bool bEnableNormalRules = Rules.bEnableNormalRules;
+    bool bEnableORMRules = Rules.bEnableORMRules;
+    bool bCheckMipGen = Rules.bCheckMipGen;
+    bool bCheckLODGroup = Rules.bCheckLODGroup;
+    Ar << Version << MaxTextureSize << bCheckPowerOfTwo << bEnableNormalRules << bEnableORMRules << bCheckMipGen << bCheckLODGroup;
+
+    for (const FABVPlatformProfile& Profile : Rules.PlatformProfiles)
+    {
+        FString Name = Profile.Name.ToString();
+        int32 ProfileMaxSize = Profile.MaxTextureSize;
+        bool bRequirePowerOfTwo = Profile.bRequirePowerOfTwo;
+        bool bAllowUncompressed = Profile.bAllowUncompressed;
+        Ar << Name << ProfileMaxSize << bRequirePowerOfTwo << bAllowUncompressed;
+    }
+
+    return FIoHash(FBlake3::HashBuffer(Bytes.GetData(), Bytes.Num()));
+}
+
+FString FABVSharedCache::GetEntryPath(const FString& ObjectPath, const FIoHash& PackageHash, const FIoHash& RulesFingerprint) const
+{
+    FBlake3 Hasher;
+    Hasher.Update(&PackageHash, sizeof(PackageHash));
+    Hasher.Update(&RulesFingerprint, sizeof(RulesFingerprint));
+    Hasher.Update(*ObjectPath, ObjectPath.Len() * sizeof(TCHAR));
+    const FString Key = LexToString(FIoHash(Hasher.Finalize()));
+
+    // 和 DDC 一样按前缀分目录，单个目录不会有太多文件
+    return Directory / Key.Left(2) / Key.Mid(2, 2) / Key + TEXT(".abv");
+}
+
+bool FABVSharedCache::Get(const FString& ObjectPath, const FIoHash& PackageHash, const FIoHash& RulesFingerprint, FABVTextureIssue& OutIssue)
+{
+    const FString EntryPath = GetEntryPath(ObjectPath, PackageHash, RulesFingerprint);
+
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *EntryPath, FILEREAD_Silent))
+    {
+        NumMisses++;
+        return false;
+    }
+
+    FMemoryReader Ar(Bytes);
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    Ar << Magic << Version;
+    if (Magic != ABV_SharedCacheMagic || Version != ABV_SharedCacheVersion)
+    {
+        NumMisses++;
+        return false;
+    }
+
+    FIoHash StoredHash;
+    FABVTextureIssue Issue;
+    ABV_SerializeIssue(Ar, Issue, StoredHash);
+    if (Ar.IsError() || StoredHash != PackageHash || Issue.AssetPath != ObjectPath)
+    {
+        NumMisses++;
+        return false;
+    }
+
+    // 命中时不写共享目录，只记下来；淘汰前统一更新时间戳
+    PendingTouches.Add(EntryPath);
+
+    OutIssue = MoveTemp(Issue);
+    NumHits++;
+    return true;
+}
+
+void FABVSharedCache::Put(const FString& ObjectPath, const FIoHash& PackageHash, const FIoHash& RulesFingerprint, const FABVTextureIssue& Issue)
+{
+    const FString EntryPath = GetEntryPath(ObjectPath, PackageHash, RulesFingerprint);
+    if (IFileManager::Get().FileExists(*EntryPath))
+    {
+        return;   // 其他机器已经写过，内容相同
+    }
+
+    TArray<uint8> Bytes;
+    FMemoryWriter Ar(Bytes);
+    uint32 Magic = ABV_SharedCacheMagic;
+    uint32 Version = ABV_SharedCacheVersion;
+    Ar << Magic << Version;
+
+    FABVTextureIssue Row = Issue;
+    Row.bSelected = false;
+    Row.bStale = false;
+    FIoHash Hash = PackageHash;
+    ABV_SerializeIssue(Ar, Row, Hash);
+
+    // 每个写入者用唯一的临时文件名，改名是原子的；并发写同一个 key 时谁最后改名都一样
+    const FString TempPath = EntryPath + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+    if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ABV: Failed to write shared cache entry %s"), *TempPath);
+        return;
+    }
+    if (!IFileManager::Get().Move(*EntryPath, *TempPath, /*bReplace=*/true, /*bEvenIfReadOnly=*/false, /*bAttributes=*/false, /*bDoNotRetryOrError=*/true))
+    {
+        IFileManager::Get().Delete(*TempPath, false, false, true);
+        return;
+    }
+    NumPuts++;
+}
+
+void FABVSharedCache::EvictIfNeeded()
+{
+    if (MaxBytes <= 0) return;
+
+    const double Now = FPlatformTime::Seconds();
+    if (Now - LastEvictTime < ABV_SharedCacheEvictInterval || !EvictTask.IsCompleted())
+    {
+        return;
+    }
+    LastEvictTime = Now;
+
+    // 后台线程只用拷贝出去的参数，不碰 this 上的其他状态
+    EvictTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+        [Directory = Directory, MaxBytes = MaxBytes, Touched = MoveTemp(PendingTouches)]()
+        {
+            EvictDirectory(Directory, MaxBytes, Touched);
+        },
+        UE::Tasks::ETaskPriority::BackgroundLow);
+    PendingTouches.Reset();
+}
+
+void FABVSharedCache::Evict()
+{
+    EvictTask.Wait();
+    if (MaxBytes <= 0) return;
+
+    LastEvictTime = FPlatformTime::Seconds();
+    EvictDirectory(Directory, MaxBytes, PendingTouches);
+    PendingTouches.Reset();
+}
+
+void FABVSharedCache::EvictDirectory(const FString& Directory, int64 MaxBytes, const TSet<FString>& Touched)
+{
+    // 每个命中的条目每轮只写一次时间戳
+    const FDateTime Now = FDateTime::UtcNow();
+    for (const FString& EntryPath : Touched)
+    {
+        IFileManager::Get().SetTimeStamp(*EntryPath, Now);
+    }
+
+    struct FEntry
+    {
+        FString Path;
+        int64 Size = 0;
+        FDateTime AccessTime;
+    };
+    TArray<FEntry> Entries;
+    int64 TotalBytes = 0;
+
+    IFileManager::Get().IterateDirectoryStatRecursively(*Directory, [&Entries, &TotalBytes](const TCHAR* Path, const FFileStatData& Stat)
+    {
+        if (!Stat.bIsDirectory && FStringView(Path).EndsWith(TEXT(".abv")))
+        {
+            FEntry& E = Entries.AddDefaulted_GetRef();
+            E.Path = Path;
+            E.Size = Stat.FileSize;
+            E.AccessTime = Stat.ModificationTime;
+            TotalBytes += Stat.FileSize;
+        }
+        return true;
+    });
+
+    if (TotalBytes <= MaxBytes)
+    {
+        return;
+    }
+
+    // 删到 90%，避免每次写入都触发淘汰
+    const int64 Target = MaxBytes - MaxBytes / 10;
+    Entries.Sort([](const FEntry& A, const FEntry& B) { return A.AccessTime < B.AccessTime; });
+
+    int32 NumDeleted = 0;
+    for (const FEntry& E : Entries)
+    {
+        if (TotalBytes <= Target) break;
+        if (IFileManager::Get().Delete(*E.Path, false, false, true))
+        {
+            TotalBytes -= E.Size;
+            NumDeleted++;
+        }
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("ABV: Shared cache evicted %d entries, %.1f MB remaining in %s"),
+        NumDeleted, TotalBytes / (1024.0 * 1024.0), *Directory);
+}
@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IO/IoHash.h"
+#include "Tasks/Task.h"
+#include "ABVTypes.h"
+
+/**
+ * Validation results shared between machines through a plain directory (local disk or network share),
+ * laid out like a shared DDC: one small file per result, keyed by package saved-hash + rules fingerprint + object path.
+ * Any machine may read and populate it. Writes go to a unique temp file and are renamed into place,
+ * so readers never see partial entries; the least recently used entries are evicted when the directory exceeds MaxBytes.
+ * Hits are only recorded in memory and their timestamps refreshed in one pass right before eviction.
+ */
+class FABVSharedCache
+{
+public:
+    FABVSharedCache(const FString& InDirectory, int64 InMaxBytes);
+    ~FABVSharedCache();
+
+    const FString& GetDirectory() const { return Directory; }
+
+    // Hash of everything in the rules that affects a result; entries from other rule sets never match
+    static FIoHash ComputeRulesFingerprint(const FABVRuleSettings& Rules);
+
+    bool Get(const FString& ObjectPath, const FIoHash& PackageHash, const FIoHash& RulesFingerprint, FABVTextureIssue& OutIssue);
+    void Put(const FString& ObjectPath, const FIoHash& PackageHash, const FIoHash& RulesFingerprint, const FABVTextureIssue& Issue);
+
+    // Starts a background eviction pass at most every 10 minutes (the first one 10 minutes after creation)
+    void EvictIfNeeded();
+
+    // Refreshes hit timestamps and deletes least recently used entries until the directory is under MaxBytes.
+    // Runs on the calling thread; meant for the commandlet at the end of a run.
+    void Evict();
+
+    int32 GetNumHits() const { return NumHits; }
+    int32 GetNumMisses() const { return NumMisses; }
+    int32 GetNumPuts() const { return NumPuts; }
+
+private:
+    FString GetEntryPath(const FString& ObjectPath, const FIoHash& PackageHash, const FIoHash& RulesFingerprint) const;
+
+    static void EvictDirectory(const FString& Directory, int64 MaxBytes, const TSet<FString>& Touched);
+
+    FString Directory;
+    int64 MaxBytes = 0;
+    double LastEvictTime = 0.0;
+
+    TSet<FString> PendingTouches;   // entries hit since the last eviction pass
+    UE::Tasks::FTask EvictTask;
+
+    int32 NumHits = 0;
+    int32 NumMisses = 0;
+    int32 NumPuts = 0;
+};
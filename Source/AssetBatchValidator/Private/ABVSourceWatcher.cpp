@@ -0,0 +1,387 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ABVSourceWatcher.h"
+
+#include "Algo/AnyOf.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "DirectoryWatcherModule.h"
+#include "EditorFramework/AssetImportData.h"
+#include "EditorReimportHandler.h"
+#include "Engine/Texture2D.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+
+// 美术保存一次文件会触发多个事件，静默这么久后再处理
+static constexpr double ABV_SourceDebounceSeconds = 1.0;
+
+// 重新导入是同步的，每次 tick 只做几个，剩下的排队
+static constexpr int32 ABV_MaxReimportsPerTick = 4;
+
+// 兄弟目录合并到共同祖先时最多往上走几层
+static constexpr int32 ABV_MaxWatchRootMergeLevels = 2;
+
+FABVSourceWatcher::FABVSourceWatcher(bool bInReimport)
+    : bReimport(bInReimport)
+{
+}
+
+FABVSourceWatcher::~FABVSourceWatcher()
+{
+    Stop();
+}
+
+FString FABVSourceWatcher::NormalizePath(const FString& Path)
+{
+    FString Result = FPaths::ConvertRelativePathToFull(Path);
+    FPaths::NormalizeFilename(Result);
+    FPaths::RemoveDuplicateSlashes(Result);
+    return Result;
+}
+
+bool FABVSourceWatcher::IsTooBroadToWatch(const FString& Dir)
+{
+    // "/"、"C:"、"/home" 这类只有一层的目录
+    TArray<FString> Parts;
+    Dir.ParseIntoArray(Parts, TEXT("/"));
+    if (Parts.Num() < 2)
+    {
+        return true;
+    }
+
+    FString Home = NormalizePath(FPlatformProcess::UserHomeDir());
+    Home.RemoveFromEnd(TEXT("/"));
+    return !Home.IsEmpty() && (Dir == Home || Home.StartsWith(Dir + TEXT("/")));
+}
+
+void FABVSourceWatcher::Start()
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+    FARFilter Filter;
+    Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
+    Filter.bRecursiveClasses = true;
+    AssetRegistry.EnumerateAssets(Filter, [this](const FAssetData& AD)
+    {
+        AddAsset(AD);
+        return true;
+    });
+    UpdateWatchRoots();
+
+    AssetAddedHandle = AssetRegistry.OnAssetAdded().AddSP(this, &FABVSourceWatcher::HandleAssetAdded);
+    AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddSP(this, &FABVSourceWatcher::HandleAssetRemoved);
+    AssetUpdatedHandle = AssetRegistry.OnAssetUpdated().AddSP(this, &FABVSourceWatcher::HandleAssetUpdated);
+
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateSP(this, &FABVSourceWatcher::Tick), 0.25f);
+
+    UE_LOG(LogTemp, Display, TEXT("ABV: Watching %d import source files under %d directories (index built in %.1f ms)"),
+        AssetsBySource.Num(), WatchRoots.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FABVSourceWatcher::Stop()
+{
+    if (FModuleManager::Get().IsModuleLoaded("AssetRegistry"))
+    {
+        IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+        AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+        AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+        AssetRegistry.OnAssetUpdated().Remove(AssetUpdatedHandle);
+    }
+    AssetAddedHandle.Reset();
+    AssetRemovedHandle.Reset();
+    AssetUpdatedHandle.Reset();
+
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+
+    if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>("DirectoryWatcher"))
+    {
+        if (IDirectoryWatcher* Watcher = DirectoryWatcherModule->Get())
+        {
+            for (const TPair<FString, FDelegateHandle>& Root : WatchRoots)
+            {
+                Watcher->UnregisterDirectoryChangedCallback_Handle(Root.Key, Root.Value);
+            }
+        }
+    }
+    WatchRoots.Reset();
+    HandledSourceDirs.Reset();
+    PendingAssets.Reset();
+    ReimportQueue.Reset();
+}
+
+void FABVSourceWatcher::AddAsset(const FAssetData& AD)
+{
+    FString ImportDataJson;
+    if (!AD.GetTagValue(UObject::SourceFileTagName(), ImportDataJson))
+    {
+        return;
+    }
+
+    TOptional<FAssetImportInfo> ImportInfo = FAssetImportInfo::FromJson(ImportDataJson);
+    if (!ImportInfo.IsSet())
+    {
+        return;
+    }
+
+    // 相对路径是相对 package 文件所在目录（和 UAssetImportData::ResolveImportFilename 一致）
+    FString PackageFilename;
+    FPackageName::TryConvertLongPackageNameToFilename(AD.PackageName.ToString(), PackageFilename);
+    const FString PackageDir = FPaths::GetPath(FPaths::ConvertRelativePathToFull(PackageFilename));
+
+    const FString ObjectPath = AD.GetObjectPathString();
+    for (const FAssetImportInfo::FSourceFile& File : ImportInfo->SourceFiles)
+    {
+        if (File.RelativeFilename.IsEmpty()) continue;
+
+        const FString Source = NormalizePath(FPaths::IsRelative(File.RelativeFilename)
+            ? PackageDir / File.RelativeFilename
+            : File.RelativeFilename);
+
+        AssetsBySource.FindOrAdd(Source).AddUnique(ObjectPath);
+        SourcesByAsset.FindOrAdd(ObjectPath).AddUnique(Source);
+
+        // 每次保存都会走到这里：只有源文件落在新目录时才需要重建监视根
+        if (!bWatchRootsDirty && !IsSourceDirHandled(FPaths::GetPath(Source)))
+        {
+            bWatchRootsDirty = true;
+        }
+    }
+}
+
+bool FABVSourceWatcher::IsSourceDirHandled(const FString& Dir) const
+{
+    if (HandledSourceDirs.Contains(Dir))
+    {
+        return true;
+    }
+    for (const TPair<FString, FDelegateHandle>& Root : WatchRoots)
+    {
+        if (Dir == Root.Key || Dir.StartsWith(Root.Key + TEXT("/")))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FABVSourceWatcher::RemoveAsset(const FString& ObjectPath)
+{
+    TArray<FString> Sources;
+    if (!SourcesByAsset.RemoveAndCopyValue(ObjectPath, Sources))
+    {
+        return;
+    }
+
+    for (const FString& Source : Sources)
+    {
+        if (TArray<FString>* Assets = AssetsBySource.Find(Source))
+        {
+            Assets->Remove(ObjectPath);
+            if (Assets->Num() == 0)
+            {
+                AssetsBySource.Remove(Source);
+            }
+        }
+    }
+    // 不缩减监视目录：多监视一个目录只是多一些被忽略的事件
+}
+
+void FABVSourceWatcher::UpdateWatchRoots()
+{
+    bWatchRootsDirty = false;
+
+    TSet<FString> Dirs;
+    for (const TPair<FString, TArray<FString>>& Pair : AssetsBySource)
+    {
+        Dirs.Add(FPaths::GetPath(Pair.Key));
+    }
+    // 不存在或过宽而没有监视的目录也记下来，之后同目录的源文件不再触发重建
+    HandledSourceDirs = Dirs;
+
+    // 最小覆盖：父目录已监视的子目录不再单独注册（监视是递归的）
+    TArray<FString> Sorted = Dirs.Array();
+    Sorted.Sort();
+    TArray<FString> Roots;
+    for (const FString& Dir : Sorted)
+    {
+        const bool bCovered = Roots.ContainsByPredicate([&Dir](const FString& Root)
+        {
+            return Dir.StartsWith(Root + TEXT("/"));
+        });
+        if (!bCovered && IFileManager::Get().DirectoryExists(*Dir))
+        {
+            Roots.Add(Dir);
+        }
+    }
+
+    // 源文件分散在很多兄弟目录时合并到共同父目录，逐层往上，但不越过过宽的目录
+    for (int32 Level = 0; Level < ABV_MaxWatchRootMergeLevels; ++Level)
+    {
+        TMap<FString, int32> NumByParent;
+        for (const FString& Root : Roots)
+        {
+            NumByParent.FindOrAdd(FPaths::GetPath(Root))++;
+        }
+
+        TArray<FString> Merged;
+        for (const FString& Root : Roots)
+        {
+            const FString Parent = FPaths::GetPath(Root);
+            const bool bMerge = NumByParent.FindChecked(Parent) > 1 && !IsTooBroadToWatch(Parent);
+            Merged.AddUnique(bMerge ? Parent : Root);
+        }
+
+        Merged.Sort();
+        Roots.Reset();
+        for (const FString& Dir : Merged)
+        {
+            if (!Roots.ContainsByPredicate([&Dir](const FString& Root) { return Dir.StartsWith(Root + TEXT("/")); }))
+            {
+                Roots.Add(Dir);
+            }
+        }
+    }
+
+    Roots.RemoveAll([](const FString& Root)
+    {
+        if (IsTooBroadToWatch(Root))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ABV: Not watching %s for import source changes (too broad)"), *Root);
+            return true;
+        }
+        return false;
+    });
+
+    FDirectoryWatcherModule& DirectoryWatcherModule =
+        FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>("DirectoryWatcher");
+    IDirectoryWatcher* Watcher = DirectoryWatcherModule.Get();
+    if (!Watcher)
+    {
+        return;
+    }
+
+    for (const FString& Root : Roots)
+    {
+        const bool bCoveredByExisting = WatchRoots.Contains(Root) || Algo::AnyOf(WatchRoots, [&Root](const TPair<FString, FDelegateHandle>& Existing)
+        {
+            return Root.StartsWith(Existing.Key + TEXT("/"));
+        });
+        if (bCoveredByExisting) continue;
+
+        FDelegateHandle Handle;
+        if (!Watcher->RegisterDirectoryChangedCallback_Handle(Root,
+            IDirectoryWatcher::FDirectoryChanged::CreateSP(this, &FABVSourceWatcher::HandleDirectoryChanged), Handle))
+        {
+            continue;
+        }
+
+        // 新的根覆盖了之前注册的子目录，旧的注销，避免同一事件收到两次
+        for (auto It = WatchRoots.CreateIterator(); It; ++It)
+        {
+            if (It.Key().StartsWith(Root + TEXT("/")))
+            {
+                Watcher->UnregisterDirectoryChangedCallback_Handle(It.Key(), It.Value());
+                It.RemoveCurrent();
+            }
+        }
+        WatchRoots.Add(Root, Handle);
+    }
+}
+
+void FABVSourceWatcher::HandleAssetAdded(const FAssetData& AD)
+{
+    if (AD.IsInstanceOf(UTexture2D::StaticClass()))
+    {
+        AddAsset(AD);
+    }
+}
+
+void FABVSourceWatcher::HandleAssetRemoved(const FAssetData& AD)
+{
+    RemoveAsset(AD.GetObjectPathString());
+}
+
+void FABVSourceWatcher::HandleAssetUpdated(const FAssetData& AD)
+{
+    // 重新导入可能换了源文件
+    if (AD.IsInstanceOf(UTexture2D::StaticClass()))
+    {
+        RemoveAsset(AD.GetObjectPathString());
+        AddAsset(AD);
+    }
+}
+
+void FABVSourceWatcher::HandleDirectoryChanged(const TArray<FFileChangeData>& Changes)
+{
+    for (const FFileChangeData& Change : Changes)
+    {
+        if (Change.Action == FFileChangeData::FCA_Removed) continue;
+
+        // 一次哈希查找；目录里其他文件的事件直接丢弃
+        if (const TArray<FString>* Assets = AssetsBySource.Find(NormalizePath(Change.Filename)))
+        {
+            PendingAssets.Append(*Assets);
+            LastChangeTime = FPlatformTime::Seconds();
+        }
+    }
+}
+
+bool FABVSourceWatcher::Tick(float DeltaTime)
+{
+    if (bWatchRootsDirty)
+    {
+        UpdateWatchRoots();
+    }
+
+    if (PendingAssets.Num() > 0 && FPlatformTime::Seconds() - LastChangeTime >= ABV_SourceDebounceSeconds)
+    {
+        TArray<FString> AssetPaths = PendingAssets.Array();
+        PendingAssets.Reset();
+
+        UE_LOG(LogTemp, Display, TEXT("ABV: %d textures affected by changed import sources%s"),
+            AssetPaths.Num(), bReimport ? TEXT(" (queued for reimport)") : TEXT(""));
+
+        if (!bReimport)
+        {
+            OnSourcesChanged.ExecuteIfBound(AssetPaths, false);
+            return true;
+        }
+
+        // 还在排队的先标记为过期，重新导入后再通知一次
+        OnSourcesChanged.ExecuteIfBound(AssetPaths, false);
+        for (const FString& Path : AssetPaths)
+        {
+            ReimportQueue.AddUnique(Path);
+        }
+    }
+
+    if (ReimportQueue.Num() == 0)
+    {
+        return true;
+    }
+
+    const int32 NumThisTick = FMath::Min(ReimportQueue.Num(), ABV_MaxReimportsPerTick);
+    TArray<FString> Reimported(ReimportQueue.GetData(), NumThisTick);
+    ReimportQueue.RemoveAt(0, NumThisTick, EAllowShrinking::No);
+
+    for (const FString& Path : Reimported)
+    {
+        if (UTexture2D* Tex = LoadObject<UTexture2D>(nullptr, *Path))
+        {
+            FReimportManager::Instance()->Reimport(Tex, /*bAskForNewFileIfMissing=*/false, /*bShowNotification=*/false);
+        }
+    }
+
+    OnSourcesChanged.ExecuteIfBound(Reimported, true);
+    return true;
+}
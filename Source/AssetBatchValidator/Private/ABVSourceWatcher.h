@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "IDirectoryWatcher.h"
+
+struct FAssetData;
+
+/**
+ * Watches the import source files (PNG, TGA, ...) referenced by textures' AssetImportData tags.
+ * A reverse index maps each source file to the textures imported from it, so a change event costs one hash lookup.
+ * Only the minimal set of root directories is registered with the directory watcher (nested directories are covered
+ * by their parent, sibling directories up to two levels apart share their common ancestor), so watch overhead depends
+ * on where sources live, not on how many there are. Filesystem, drive and home directories are never watched.
+ * Changes are debounced and delivered in batches; optionally the affected textures are reimported first,
+ * a few per tick, so a large batch of changed sources does not stall the editor.
+ */
+class FABVSourceWatcher : public TSharedFromThis<FABVSourceWatcher>
+{
+public:
+    // Affected texture object paths, and whether they were reimported before the callback
+    DECLARE_DELEGATE_TwoParams(FOnSourcesChanged, const TArray<FString>& /*AssetPaths*/, bool /*bReimported*/);
+    FOnSourcesChanged OnSourcesChanged;
+
+    explicit FABVSourceWatcher(bool bInReimport);
+    ~FABVSourceWatcher();
+
+    // Builds the index from the registry and starts watching; keeps it current through registry add/remove/update events
+    void Start();
+    void Stop();
+
+    int32 GetNumSourceFiles() const { return AssetsBySource.Num(); }
+    int32 GetNumWatchedRoots() const { return WatchRoots.Num(); }
+
+private:
+    void AddAsset(const FAssetData& AD);
+    void RemoveAsset(const FString& ObjectPath);
+    void UpdateWatchRoots();
+    // Dir is a registered root or below one, or UpdateWatchRoots already decided about it (missing / too broad)
+    bool IsSourceDirHandled(const FString& Dir) const;
+
+    void HandleAssetAdded(const FAssetData& AD);
+    void HandleAssetRemoved(const FAssetData& AD);
+    void HandleAssetUpdated(const FAssetData& AD);
+    void HandleDirectoryChanged(const TArray<FFileChangeData>& Changes);
+    bool Tick(float DeltaTime);
+
+    static FString NormalizePath(const FString& Path);
+    // Filesystem / drive roots, the user's home directory and its parents
+    static bool IsTooBroadToWatch(const FString& Dir);
+
+    bool bReimport = false;
+
+    TMap<FString, TArray<FString>> AssetsBySource;   // source file -> texture object paths
+    TMap<FString, TArray<FString>> SourcesByAsset;   // texture object path -> source files (for removal)
+
+    TMap<FString, FDelegateHandle> WatchRoots;       // registered directory -> watcher handle
+    TSet<FString> HandledSourceDirs;                 // source directories the last UpdateWatchRoots considered
+    bool bWatchRootsDirty = false;
+
+    TSet<FString> PendingAssets;
+    TArray<FString> ReimportQueue;                   // debounced, waiting for their turn to be reimported
+    double LastChangeTime = 0.0;
+    FTSTicker::FDelegateHandle TickerHandle;
+
+    FDelegateHandle AssetAddedHandle;
+    FDelegateHandle AssetRemovedHandle;
+    FDelegateHandle AssetUpdatedHandle;
+};
@@ -0,0 +1,222 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ABVStreamingScan.h"
+
+#include "AssetBatchValidator.h"
+#include "ABVMemoryTracker.h"
+#include "ABVSharedCache.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Texture2D.h"
+#include "Modules/ModuleManager.h"
+
+static constexpr int32 ABV_StreamingMemoryCheckInterval = 64;
+
+FABVStreamingScan::FABVStreamingScan(const FName& InRootPath, bool bInRecursive, const FABVRuleSettings& InRules, const FABVScanLimits& InLimits)
+    : RootPath(InRootPath)
+    , bRecursive(bInRecursive)
+    , Rules(InRules)
+    , Limits(InLimits)
+{
+    RootPrefix = RootPath.ToString();
+    if (!RootPrefix.EndsWith(TEXT("/")))
+    {
+        RootPrefix += TEXT("/");
+    }
+}
+
+FABVStreamingScan::~FABVStreamingScan()
+{
+    Cancel();
+}
+
+void FABVStreamingScan::Start()
+{
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+    bComplete = false;
+    bPartial = false;
+    NumErrors = 0;
+    NumSinceMemoryCheck = 0;
+    StartTime = FPlatformTime::Seconds();
+    bDiscovering = AssetRegistry.IsLoadingAssets();
+
+    FAssetBatchValidatorModule& Mod =
+        FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
+    RulesFingerprint = Mod.GetSharedCache() ? FABVSharedCache::ComputeRulesFingerprint(Rules) : FIoHash::Zero;
+
+    // 整个流式扫描算一个 phase，跨多帧统计峰值
+    FABVMemoryTracker::Get().BeginPhase(TEXT("Scan"));
+    bMemoryPhaseActive = true;
+
+    // 先订阅再枚举：枚举期间新发现的资源也不会漏掉，重复的由 Seen 去重
+    if (bDiscovering)
+    {
+        AssetAddedHandle = AssetRegistry.OnAssetAdded().AddSP(this, &FABVStreamingScan::HandleAssetAdded);
+        FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddSP(this, &FABVStreamingScan::HandleFilesLoaded);
+    }
+
+    FARFilter Filter;
+    Filter.PackagePaths.Add(RootPath);
+    Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
+    Filter.bRecursivePaths = bRecursive;
+
+    AssetRegistry.EnumerateAssets(Filter, [this](const FAssetData& AD)
+    {
+        Enqueue(AD);
+        return true;
+    });
+
+    UE_LOG(LogTemp, Display, TEXT("=== ABV: Streaming scan of %s started (%d known, registry %s) ==="),
+        *RootPath.ToString(), Seen.Num(), bDiscovering ? TEXT("discovering") : TEXT("idle"));
+
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateSP(this, &FABVStreamingScan::Tick));
+}
+
+void FABVStreamingScan::Cancel()
+{
+    if (FModuleManager::Get().IsModuleLoaded("AssetRegistry"))
+    {
+        IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+        AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+        AssetRegistry.OnFilesLoaded().Remove(FilesLoadedHandle);
+    }
+    AssetAddedHandle.Reset();
+    FilesLoadedHandle.Reset();
+
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+    bDiscovering = false;
+
+    if (bMemoryPhaseActive)
+    {
+        FABVMemoryTracker::Get().EndPhase(TEXT("Scan"));
+        bMemoryPhaseActive = false;
+    }
+}
+
+bool FABVStreamingScan::PassesFilter(const FAssetData& AD) const
+{
+    if (AD.AssetClassPath != UTexture2D::StaticClass()->GetClassPathName())
+    {
+        return false;
+    }
+
+    if (bRecursive)
+    {
+        return AD.PackagePath == RootPath || AD.PackagePath.ToString().StartsWith(RootPrefix);
+    }
+    return AD.PackagePath == RootPath;
+}
+
+void FABVStreamingScan::Enqueue(const FAssetData& AD)
+{
+    const FSoftObjectPath ObjectPath = AD.GetSoftObjectPath();
+    bool bAlreadySeen = false;
+    Seen.Add(ObjectPath, &bAlreadySeen);
+    if (!bAlreadySeen)
+    {
+        FPendingAsset Item;
+        Item.AssetData = AD;
+        if (Limits.bImpactOrder)
+        {
+            // 只看 tag，不 stat 文件，游戏线程上保持便宜
+            Item.Impact = ABV_EstimateImpact(AD, Rules, /*bWithTimestamp=*/false);
+        }
+        Pending.HeapPush(MoveTemp(Item), FPendingAssetPredicate());
+    }
+}
+
+void FABVStreamingScan::HandleAssetAdded(const FAssetData& AD)
+{
+    if (PassesFilter(AD))
+    {
+        Enqueue(AD);
+    }
+}
+
+void FABVStreamingScan::HandleFilesLoaded()
+{
+    bDiscovering = false;
+
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+    AssetRegistry.OnFilesLoaded().Remove(FilesLoadedHandle);
+    AssetAddedHandle.Reset();
+    FilesLoadedHandle.Reset();
+}
+
+bool FABVStreamingScan::Tick(float DeltaTime)
+{
+    FAssetBatchValidatorModule& Mod =
+        FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
+
+    // 每帧约 8ms，编辑器保持可交互
+    const double Deadline = FPlatformTime::Seconds() + 0.008;
+
+    ABV_LLM_SCOPE();
+
+    TArray<FABVTextureIssue> NewIssues;
+    while (Pending.Num() > 0 && FPlatformTime::Seconds() < Deadline && !bPartial)
+    {
+        FPendingAsset Item;
+        Pending.HeapPop(Item, FPendingAssetPredicate(), EAllowShrinking::No);
+
+        // 直接走单资源验证：指纹、LLM scope 和内存 phase 都在扫描级别，不按资源重复
+        FABVTextureIssue Issue;
+        if (Mod.ValidateAsset(Item.AssetData, Rules, RulesFingerprint, Issue))
+        {
+            NumErrors += (Issue.Severity == EABVIssueSeverity::Error) ? 1 : 0;
+            NewIssues.Add(MoveTemp(Issue));
+        }
+
+        // 不经过 ValidateAssets 的批内节流：每验证一批数量检查一次预算（GC 本身有频率限制），新加载的贴图持有数有上限
+        if (++NumSinceMemoryCheck >= ABV_StreamingMemoryCheckInterval)
+        {
+            FABVMemoryTracker::Get().CollectIfOverBudget();
+            NumSinceMemoryCheck = 0;
+        }
+        FABVMemoryTracker::Get().ReleaseScanLoads(FABVMemoryTracker::MaxScanLoads);
+
+        const bool bHitErrorLimit = Limits.MaxErrors > 0 && NumErrors >= Limits.MaxErrors;
+        const bool bHitTimeLimit = Limits.TimeBudgetSeconds > 0.0 && (FPlatformTime::Seconds() - StartTime) >= Limits.TimeBudgetSeconds;
+        bPartial = bHitErrorLimit || bHitTimeLimit;
+    }
+
+    if (NewIssues.Num() > 0)
+    {
+        OnIssues.ExecuteIfBound(NewIssues);
+    }
+
+    if (bPartial || (!bDiscovering && Pending.Num() == 0))
+    {
+        bComplete = true;
+        TickerHandle.Reset();
+        if (bPartial)
+        {
+            Cancel();
+        }
+        FABVMemoryTracker::Get().ReleaseScanLoads();
+        if (bMemoryPhaseActive)
+        {
+            FABVMemoryTracker::Get().EndPhase(TEXT("Scan"));
+            bMemoryPhaseActive = false;
+        }
+        if (FABVSharedCache* SharedCache = Mod.GetSharedCache())
+        {
+            SharedCache->EvictIfNeeded();
+        }
+
+        UE_LOG(LogTemp, Display, TEXT("=== ABV: Streaming scan of %s %s (%d textures discovered, %d pending) ==="),
+            *RootPath.ToString(), bPartial ? TEXT("stopped early") : TEXT("complete"), Seen.Num(), Pending.Num());
+
+        OnComplete.ExecuteIfBound();
+        return false;
+    }
+    return true;
+}
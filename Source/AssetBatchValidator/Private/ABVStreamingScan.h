@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Containers/Ticker.h"
+#include "IO/IoHash.h"
+#include "ABVTypes.h"
+#include "ABVScheduler.h"
+
+/**
+ * Texture scan that runs while the asset registry is still discovering assets.
+ *
+ * Assets already known are pulled with EnumerateAssets (no intermediate TArray<FAssetData>), newly
+ * discovered ones arrive through OnAssetAdded. Both feed a pending queue that is validated in time
+ * slices on the core ticker, so validation overlaps with discovery. Object paths are deduplicated,
+ * and the scan completes only after OnFilesLoaded has fired and the queue is drained.
+ *
+ * The queue is a max-heap on FABVImpactKey, so the likely worst offenders reach the panel first.
+ */
+class FABVStreamingScan : public TSharedFromThis<FABVStreamingScan>
+{
+public:
+    DECLARE_DELEGATE_OneParam(FOnIssues, const TArray<FABVTextureIssue>& /*NewIssues*/);
+    DECLARE_DELEGATE(FOnComplete);
+
+    FABVStreamingScan(const FName& InRootPath, bool bInRecursive, const FABVRuleSettings& InRules, const FABVScanLimits& InLimits = FABVScanLimits());
+    ~FABVStreamingScan();
+
+    void Start();
+    void Cancel();
+    bool IsComplete() const { return bComplete; }
+    bool IsPartial() const { return bPartial; }   // stopped by a fail-fast limit
+    int32 GetNumDiscovered() const { return Seen.Num(); }
+
+    FOnIssues OnIssues;
+    FOnComplete OnComplete;
+
+private:
+    bool PassesFilter(const FAssetData& AD) const;
+    void Enqueue(const FAssetData& AD);
+    void HandleAssetAdded(const FAssetData& AD);
+    void HandleFilesLoaded();
+    bool Tick(float DeltaTime);
+
+    FName RootPath;
+    FString RootPrefix;   // "/Game/Foo/" for recursive prefix tests
+    bool bRecursive = true;
+    FABVRuleSettings Rules;
+    FABVScanLimits Limits;
+    FIoHash RulesFingerprint;   // computed once in Start, not per asset
+
+    struct FPendingAsset
+    {
+        FAssetData AssetData;
+        FABVImpactKey Impact;
+    };
+    struct FPendingAssetPredicate
+    {
+        bool operator()(const FPendingAsset& A, const FPendingAsset& B) const { return A.Impact > B.Impact; }
+    };
+
+    TSet<FSoftObjectPath> Seen;
+    TArray<FPendingAsset> Pending;   // heap, worst first
+
+    double StartTime = 0.0;
+    int32 NumErrors = 0;
+    int32 NumSinceMemoryCheck = 0;   // assets validated since the last budget check
+
+    bool bDiscovering = false;
+    bool bComplete = false;
+    bool bPartial = false;
+    bool bMemoryPhaseActive = false;
+
+    FDelegateHandle AssetAddedHandle;
+    FDelegateHandle FilesLoadedHandle;
+    FTSTicker::FDelegateHandle TickerHandle;
+};
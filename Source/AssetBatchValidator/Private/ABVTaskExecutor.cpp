@@ -0,0 +1,166 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ABVTaskExecutor.h"
+
+#include "Async/TaskGraphInterfaces.h"
+#include "Misc/App.h"
+#include "Tasks/Task.h"
+
+#include <atomic>
+
+// 每批目标耗时；太小则 CAS 和计时开销占比高，太大则尾部不均衡
+static constexpr double ABV_TargetBatchSeconds = 0.0005;
+static constexpr int32 ABV_MaxBatchSize = 4096;
+
+namespace
+{
+    // [Begin, End) packed into one word: Begin low 32 bits, End high 32 bits
+    struct alignas(PLATFORM_CACHE_LINE_SIZE) FABVWorkerRange
+    {
+        std::atomic<uint64> Packed{ 0 };
+    };
+
+    inline uint64 ABV_PackRange(uint32 Begin, uint32 End)
+    {
+        return (static_cast<uint64>(End) << 32) | Begin;
+    }
+
+    inline void ABV_UnpackRange(uint64 Packed, uint32& OutBegin, uint32& OutEnd)
+    {
+        OutBegin = static_cast<uint32>(Packed);
+        OutEnd = static_cast<uint32>(Packed >> 32);
+    }
+}
+
+void ABV_ParallelForAdaptive(int32 Num, TFunctionRef<void(int32)> Body, FABVExecutorStats* OutStats)
+{
+    if (Num <= 0) return;
+
+    const bool bThreaded = FApp::ShouldUseThreadingForPerformance() && FTaskGraphInterface::IsRunning();
+    const int32 NumWorkers = bThreaded ? FMath::Clamp(FTaskGraphInterface::Get().GetNumWorkerThreads() + 1, 1, Num) : 1;
+    if (NumWorkers == 1)
+    {
+        for (int32 i = 0; i < Num; ++i)
+        {
+            Body(i);
+        }
+        if (OutStats) *OutStats = FABVExecutorStats{ 1, 1, 0 };
+        return;
+    }
+
+    TUniquePtr<FABVWorkerRange[]> Ranges = MakeUnique<FABVWorkerRange[]>(NumWorkers);
+    for (int32 w = 0; w < NumWorkers; ++w)
+    {
+        const uint32 Begin = static_cast<uint32>(static_cast<int64>(Num) * w / NumWorkers);
+        const uint32 End = static_cast<uint32>(static_cast<int64>(Num) * (w + 1) / NumWorkers);
+        Ranges[w].Packed.store(ABV_PackRange(Begin, End), std::memory_order_relaxed);
+    }
+
+    std::atomic<int32> NumBatches{ 0 };
+    std::atomic<int32> NumSteals{ 0 };
+
+    // 从剩余最多的 worker 尾部偷一半，放进自己（已空）的区间。全部为空时返回 false。
+    // 区间状态完整地存在一个字里，CAS 比较的就是状态本身，不存在 ABA 问题
+    auto Steal = [&Ranges, NumWorkers](int32 Self) -> bool
+    {
+        for (;;)
+        {
+            int32 Victim = INDEX_NONE;
+            uint64 VictimPacked = 0;
+            uint32 Largest = 0;
+            for (int32 w = 0; w < NumWorkers; ++w)
+            {
+                if (w == Self) continue;
+
+                const uint64 Packed = Ranges[w].Packed.load(std::memory_order_acquire);
+                uint32 Begin, End;
+                ABV_UnpackRange(Packed, Begin, End);
+                if (End > Begin && End - Begin > Largest)
+                {
+                    Largest = End - Begin;
+                    Victim = w;
+                    VictimPacked = Packed;
+                }
+            }
+            if (Victim == INDEX_NONE)
+            {
+                return false;
+            }
+
+            uint32 Begin, End;
+            ABV_UnpackRange(VictimPacked, Begin, End);
+            const uint32 Half = (End - Begin + 1) / 2;
+            if (Ranges[Victim].Packed.compare_exchange_strong(VictimPacked, ABV_PackRange(Begin, End - Half), std::memory_order_acq_rel))
+            {
+                Ranges[Self].Packed.store(ABV_PackRange(End - Half, End), std::memory_order_release);
+                return true;
+            }
+        }
+    };
+
+    auto WorkerLoop = [&](int32 Self)
+    {
+        double CostPerItem = 0.0;
+        uint32 BatchSize = 1;   // 代价未知时从 1 开始，测一批之后再调整
+
+        for (;;)
+        {
+            FABVWorkerRange& Own = Ranges[Self];
+            uint64 Packed = Own.Packed.load(std::memory_order_acquire);
+            uint32 Begin = 0;
+            uint32 End = 0;
+            bool bClaimed = false;
+            for (;;)
+            {
+                ABV_UnpackRange(Packed, Begin, End);
+                if (Begin >= End) break;
+
+                const uint32 Take = FMath::Min(BatchSize, End - Begin);
+                if (Own.Packed.compare_exchange_weak(Packed, ABV_PackRange(Begin + Take, End), std::memory_order_acq_rel))
+                {
+                    End = Begin + Take;
+                    bClaimed = true;
+                    break;
+                }
+            }
+
+            if (!bClaimed)
+            {
+                if (!Steal(Self))
+                {
+                    return;   // 没有未领取的下标了；别人手里正在执行的批次由它们自己完成
+                }
+                NumSteals.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            const double StartTime = FPlatformTime::Seconds();
+            for (uint32 i = Begin; i < End; ++i)
+            {
+                Body(static_cast<int32>(i));
+            }
+            const double ItemCost = (FPlatformTime::Seconds() - StartTime) / (End - Begin);
+            NumBatches.fetch_add(1, std::memory_order_relaxed);
+
+            // 指数滑动平均，贵的资源出现时批大小很快缩小
+            CostPerItem = CostPerItem > 0.0 ? 0.5 * CostPerItem + 0.5 * ItemCost : ItemCost;
+            BatchSize = static_cast<uint32>(FMath::Clamp(ABV_TargetBatchSeconds / FMath::Max(CostPerItem, 1e-9), 1.0, static_cast<double>(ABV_MaxBatchSize)));
+        }
+    };
+
+    TArray<UE::Tasks::FTask> Tasks;
+    Tasks.Reserve(NumWorkers - 1);
+    for (int32 w = 1; w < NumWorkers; ++w)
+    {
+        Tasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&WorkerLoop, w]() { WorkerLoop(w); }));
+    }
+    WorkerLoop(0);
+    UE::Tasks::Wait(Tasks);
+
+    if (OutStats)
+    {
+        OutStats->NumWorkers = NumWorkers;
+        OutStats->NumBatches = NumBatches.load();
+        OutStats->NumSteals = NumSteals.load();
+    }
+}
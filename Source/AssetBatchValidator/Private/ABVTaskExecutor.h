@@ -0,0 +1,67 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+
+#include <atomic>
+
+struct FABVExecutorStats
+{
+    int32 NumWorkers = 0;
+    int32 NumBatches = 0;
+    int32 NumSteals = 0;
+};
+
+/**
+ * Parallel-for for validator work whose per-item cost varies by orders of magnitude (tag checks next to 8K decodes).
+ * Each worker owns a contiguous index range and takes batches from its front; an idle worker steals half of the
+ * largest remaining range from the back. Ranges are one packed [begin, end) word updated with CAS, so there are no locks.
+ * Each worker sizes its batches from the measured per-item cost so a batch takes about half a millisecond.
+ * Body runs on task-graph workers and the calling thread; it must not touch UObjects.
+ */
+void ABV_ParallelForAdaptive(int32 Num, TFunctionRef<void(int32 /*Index*/)> Body, FABVExecutorStats* OutStats = nullptr);
+
+/**
+ * Lock-free multi-producer / single-consumer hand-off for results made on workers (TQueue Mpsc).
+ * Producers push from any thread while the consumer drains on its own thread, so results can be consumed
+ * (e.g. UObject work on the game thread) while the parallel phase is still running.
+ */
+template<typename T>
+class TABVResultChannel
+{
+public:
+    void Push(T&& Item)
+    {
+        Queue.Enqueue(MoveTemp(Item));
+        NumPending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Push(const T& Item)
+    {
+        Queue.Enqueue(Item);
+        NumPending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Consumer thread only. Appends everything pushed so far to Out, returns how many.
+    int32 Drain(TArray<T>& Out)
+    {
+        int32 Count = 0;
+        T Item;
+        while (Queue.Dequeue(Item))
+        {
+            Out.Add(MoveTemp(Item));
+            ++Count;
+        }
+        NumPending.fetch_sub(Count, std::memory_order_relaxed);
+        return Count;
+    }
+
+    // Approximate while producers are running
+    int32 GetNumPending() const { return NumPending.load(std::memory_order_relaxed); }
+
+private:
+    TQueue<T, EQueueMode::Mpsc> Queue;
+    std::atomic<int32> NumPending{ 0 };
+};
@@ -0,0 +1,428 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ABVTextureHashing.h"
+
+#include "ABVResultsCache.h"
+#include "AssetBatchValidator.h"
+#include "AssetRegistry/AssetData.h"
+#include "ABVMemoryTracker.h"
+#include "ABVTaskExecutor.h"
+#include "Engine/Texture2D.h"
+#include "Hash/xxhash.h"
+#include "HAL/FileManager.h"
+#include "ImageCore.h"
+#include "Math/VectorRegister.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+static constexpr uint32 ABV_HashCacheMagic = 0x48564241; // "ABVH"
+static constexpr uint32 ABV_HashCacheVersion = 2;
+
+// 9x8 网格 -> 每行 8 个相邻比较 = 64 bit
+static constexpr int32 ABV_PHashW = 9;
+static constexpr int32 ABV_PHashH = 8;
+
+// Sum of N bytes. SAD against zero on SSE2, pairwise widening adds on NEON.
+static uint32 ABV_SumBytes(const uint8* P, int32 N)
+{
+    int32 i = 0;
+    uint32 Sum = 0;
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+    uint32x4_t Acc = vdupq_n_u32(0);
+    for (; i + 16 <= N; i += 16)
+    {
+        Acc = vpadalq_u16(Acc, vpaddlq_u8(vld1q_u8(P + i)));
+    }
+    Sum = vaddvq_u32(Acc);
+#elif PLATFORM_ENABLE_VECTORINTRINSICS
+    const __m128i Zero = _mm_setzero_si128();
+    __m128i Acc = _mm_setzero_si128();
+    for (; i + 16 <= N; i += 16)
+    {
+        Acc = _mm_add_epi64(Acc, _mm_sad_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(P + i)), Zero));
+    }
+    Sum = static_cast<uint32>(_mm_cvtsi128_si32(Acc)) + static_cast<uint32>(_mm_cvtsi128_si32(_mm_srli_si128(Acc, 8)));
+#endif
+
+    for (; i < N; ++i)
+    {
+        Sum += P[i];
+    }
+    return Sum;
+}
+
+// 格子亮度极差低于此值视为纯色图，差分哈希全是噪声
+static constexpr float ABV_PHashMinContrast = 2.0f;
+
+// Box-filters a G8 image down to a 9x8 grid and builds the difference hash.
+// Returns false (hash unusable) for images smaller than the grid or without contrast.
+static bool ABV_ComputeDHash(const uint8* Luma, int32 W, int32 H, uint64& OutHash)
+{
+    OutHash = 0;
+    if (W < ABV_PHashW || H < ABV_PHashH)
+    {
+        return false;
+    }
+
+    float Cells[ABV_PHashH][ABV_PHashW];
+    for (int32 CY = 0; CY < ABV_PHashH; ++CY)
+    {
+        const int32 Y0 = CY * H / ABV_PHashH;
+        const int32 Y1 = (CY + 1) * H / ABV_PHashH;
+
+        for (int32 CX = 0; CX < ABV_PHashW; ++CX)
+        {
+            const int32 X0 = CX * W / ABV_PHashW;
+            const int32 X1 = (CX + 1) * W / ABV_PHashW;
+
+            uint64 Sum = 0;
+            for (int32 Y = Y0; Y < Y1; ++Y)
+            {
+                Sum += ABV_SumBytes(Luma + static_cast<int64>(Y) * W + X0, X1 - X0);
+            }
+            Cells[CY][CX] = static_cast<float>(Sum) / static_cast<float>(FMath::Max(1, (X1 - X0) * (Y1 - Y0)));
+        }
+    }
+
+    float MinCell = Cells[0][0];
+    float MaxCell = Cells[0][0];
+    uint64 Hash = 0;
+    for (int32 CY = 0; CY < ABV_PHashH; ++CY)
+    {
+        for (int32 CX = 0; CX < ABV_PHashW; ++CX)
+        {
+            MinCell = FMath::Min(MinCell, Cells[CY][CX]);
+            MaxCell = FMath::Max(MaxCell, Cells[CY][CX]);
+            if (CX < ABV_PHashW - 1)
+            {
+                Hash = (Hash << 1) | (Cells[CY][CX] < Cells[CY][CX + 1] ? 1ull : 0ull);
+            }
+        }
+    }
+    OutHash = Hash;
+    return MaxCell - MinCell >= ABV_PHashMinContrast;
+}
+
+static void ABV_ComputeFingerprint(const FImage& Image, FABVTextureFingerprint& Out)
+{
+    Out.Width = Image.SizeX;
+    Out.Height = Image.SizeY;
+
+    FXxHash64Builder Builder;
+    const int32 Format = static_cast<int32>(Image.Format);
+    Builder.Update(&Image.SizeX, sizeof(Image.SizeX));
+    Builder.Update(&Image.SizeY, sizeof(Image.SizeY));
+    Builder.Update(&Format, sizeof(Format));
+    Builder.Update(Image.RawData.GetData(), Image.RawData.Num());
+    Out.ContentHash = Builder.Finalize().Hash;
+
+    // 感知哈希只看亮度，先转 G8 减少带宽
+    FImage Luma;
+    Image.CopyTo(Luma, ERawImageFormat::G8, EGammaSpace::sRGB);
+    Out.bPerceptualValid = ABV_ComputeDHash(Luma.RawData.GetData(), Luma.SizeX, Luma.SizeY, Out.PerceptualHash);
+}
+
+bool ABV_FingerprintTextureSource(UTexture2D* Tex, FABVTextureFingerprint& Out)
+{
+    FImage Image;
+    if (!Tex || !Tex->Source.IsValid() || !Tex->Source.GetMipImage(Image, 0, 0, 0))
+    {
+        return false;
+    }
+    ABV_ComputeFingerprint(Image, Out);
+    return true;
+}
+
+FString FABVTextureHashIndex::GetDefaultCachePath()
+{
+    return FPaths::ProjectSavedDir() / TEXT("ABV") / TEXT("TextureHashes.bin");
+}
+
+bool FABVTextureHashIndex::LoadCache(const FString& FilePath)
+{
+    Entries.Reset();
+
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *FilePath, FILEREAD_Silent))
+    {
+        return false;
+    }
+
+    FMemoryReader Ar(Bytes);
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    int32 Count = 0;
+    Ar << Magic << Version << Count;
+    if (Magic != ABV_HashCacheMagic || Version != ABV_HashCacheVersion || Count < 0)
+    {
+        return false;
+    }
+
+    Entries.Reserve(Count);
+    for (int32 i = 0; i < Count && !Ar.IsError(); ++i)
+    {
+        FString Path;
+        FEntry E;
+        Ar << Path << E.PackageHash;
+        Ar << E.Fingerprint.ContentHash << E.Fingerprint.PerceptualHash << E.Fingerprint.bPerceptualValid;
+        Ar << E.Fingerprint.Width << E.Fingerprint.Height;
+        Entries.Add(MoveTemp(Path), E);
+    }
+
+    if (Ar.IsError())
+    {
+        Entries.Reset();
+        return false;
+    }
+    return true;
+}
+
+bool FABVTextureHashIndex::SaveCache(const FString& FilePath) const
+{
+    TArray<uint8> Bytes;
+    FMemoryWriter Ar(Bytes);
+
+    uint32 Magic = ABV_HashCacheMagic;
+    uint32 Version = ABV_HashCacheVersion;
+    int32 Count = Entries.Num();
+    Ar << Magic << Version << Count;
+
+    for (const TPair<FString, FEntry>& It : Entries)
+    {
+        FString Path = It.Key;
+        FEntry E = It.Value;
+        Ar << Path << E.PackageHash;
+        Ar << E.Fingerprint.ContentHash << E.Fingerprint.PerceptualHash << E.Fingerprint.bPerceptualValid;
+        Ar << E.Fingerprint.Width << E.Fingerprint.Height;
+    }
+
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+    const FString TempPath = FilePath + TEXT(".tmp");
+    if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath))
+    {
+        return false;
+    }
+    return IFileManager::Get().Move(*FilePath, *TempPath, /*bReplace=*/true);
+}
+
+void FABVTextureHashIndex::Update(const TArray<FAssetData>& Assets)
+{
+    CurrentScan.Reset();
+    NumHashed = 0;
+    NumReused = 0;
+
+    struct FWork
+    {
+        FString Path;
+        FIoHash PackageHash;
+        FImage Image;
+        FABVTextureFingerprint Fingerprint;
+    };
+
+    ABV_LLM_SCOPE();
+    FABVScopedMemoryPhase MemoryPhase(TEXT("Hash"));
+
+    // 每批先在游戏线程加载/解码 source，再并行计算哈希；批大小限制峰值内存，超出预算时减半
+    constexpr int32 MaxBatchSize = 16;
+    int32 BatchSize = MaxBatchSize;
+    TArray<FWork> Batch;
+    Batch.Reserve(MaxBatchSize);
+
+    auto FlushBatch = [this, &Batch, &BatchSize]()
+    {
+        ABV_ParallelForAdaptive(Batch.Num(), [&Batch](int32 Index)
+        {
+            ABV_ComputeFingerprint(Batch[Index].Image, Batch[Index].Fingerprint);
+        });
+
+        for (FWork& W : Batch)
+        {
+            FEntry& E = Entries.FindOrAdd(W.Path);
+            E.PackageHash = W.PackageHash;
+            E.Fingerprint = W.Fingerprint;
+        }
+        NumHashed += Batch.Num();
+        Batch.Reset();
+
+        BatchSize = FABVMemoryTracker::Get().AdaptBatchSize(BatchSize, 1, MaxBatchSize);
+    };
+
+    for (const FAssetData& AD : Assets)
+    {
+        const FString Path = AD.GetObjectPathString();
+        const FIoHash PackageHash = ABV_GetPackageSavedHash(Path);
+        CurrentScan.Add(Path);
+
+        const FEntry* Cached = Entries.Find(Path);
+        if (Cached && !PackageHash.IsZero() && Cached->PackageHash == PackageHash)
+        {
+            NumReused++;
+            continue;
+        }
+
+        UTexture2D* Tex = Cast<UTexture2D>(AD.GetAsset());
+        if (!Tex || !Tex->Source.IsValid())
+        {
+            continue;
+        }
+
+        FWork& W = Batch.AddDefaulted_GetRef();
+        W.Path = Path;
+        W.PackageHash = PackageHash;
+        if (!Tex->Source.GetMipImage(W.Image, 0, 0, 0))
+        {
+            Batch.Pop();
+            continue;
+        }
+
+        if (Batch.Num() >= BatchSize)
+        {
+            FlushBatch();
+        }
+    }
+    FlushBatch();
+
+    UE_LOG(LogTemp, Display, TEXT("ABV: Texture fingerprints: %d hashed, %d reused from cache"), NumHashed, NumReused);
+}
+
+void FABVTextureHashIndex::FindGroups(int32 NearThreshold, TArray<FABVDuplicateGroup>& OutGroups) const
+{
+    OutGroups.Reset();
+
+    TArray<const FABVTextureFingerprint*> Fps;
+    TArray<const FString*> Paths;
+    for (const FString& Path : CurrentScan)
+    {
+        if (const FEntry* E = Entries.Find(Path))
+        {
+            Fps.Add(&E->Fingerprint);
+            Paths.Add(&Path);
+        }
+    }
+
+    const int32 Num = Fps.Num();
+    TArray<int32> Parent;
+    Parent.SetNumUninitialized(Num);
+    for (int32 i = 0; i < Num; ++i) Parent[i] = i;
+
+    auto Find = [&Parent](int32 X)
+    {
+        while (Parent[X] != X)
+        {
+            Parent[X] = Parent[Parent[X]];
+            X = Parent[X];
+        }
+        return X;
+    };
+    auto Union = [&Parent, &Find](int32 A, int32 B)
+    {
+        A = Find(A);
+        B = Find(B);
+        if (A != B) Parent[B] = A;
+    };
+
+    // 1) exact: same content hash
+    TMap<uint64, int32> FirstByContent;
+    for (int32 i = 0; i < Num; ++i)
+    {
+        if (const int32* First = FirstByContent.Find(Fps[i]->ContentHash))
+        {
+            Union(*First, i);
+        }
+        else
+        {
+            FirstByContent.Add(Fps[i]->ContentHash, i);
+        }
+    }
+
+    // 2) near: pigeonhole over 4 x 16-bit bands -- Hamming <= 3 guarantees one identical band.
+    //    Larger thresholds still work but may miss some pairs.
+    //    Flat / tiny sources have no usable perceptual hash and only take part in exact grouping.
+    if (NearThreshold > 0)
+    {
+        constexpr int32 MaxCompareInBucket = 64;
+        int32 NumTruncatedBuckets = 0;
+        int64 NumSkippedCompares = 0;
+
+        TMap<uint32, TArray<int32>> Buckets;
+        for (int32 i = 0; i < Num; ++i)
+        {
+            if (!Fps[i]->bPerceptualValid) continue;
+
+            for (uint32 Band = 0; Band < 4; ++Band)
+            {
+                const uint32 Key = (Band << 16) | static_cast<uint32>((Fps[i]->PerceptualHash >> (Band * 16)) & 0xFFFF);
+                TArray<int32>& Bucket = Buckets.FindOrAdd(Key);
+                if (Bucket.Num() == MaxCompareInBucket)
+                {
+                    NumTruncatedBuckets++;
+                }
+                NumSkippedCompares += FMath::Max(0, Bucket.Num() - MaxCompareInBucket);
+
+                for (int32 k = 0; k < FMath::Min(Bucket.Num(), MaxCompareInBucket); ++k)
+                {
+                    const int32 j = Bucket[k];
+                    const float AspectI = static_cast<float>(Fps[i]->Width) / FMath::Max(1, Fps[i]->Height);
+                    const float AspectJ = static_cast<float>(Fps[j]->Width) / FMath::Max(1, Fps[j]->Height);
+                    if (!FMath::IsNearlyEqual(AspectI, AspectJ, 0.01f)) continue;
+
+                    const int32 Distance = FMath::CountBits(Fps[i]->PerceptualHash ^ Fps[j]->PerceptualHash);
+                    if (Distance <= NearThreshold)
+                    {
+                        Union(i, j);
+                    }
+                }
+                Bucket.Add(i);
+            }
+        }
+
+        if (NumTruncatedBuckets > 0)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ABV: %d perceptual-hash buckets exceeded %d entries, %lld near-duplicate comparisons skipped; some near duplicates may be missed"),
+                NumTruncatedBuckets, MaxCompareInBucket, NumSkippedCompares);
+        }
+    }
+
+    // 3) collect groups; keeper = largest source, then shortest path
+    TMap<int32, TArray<int32>> Members;
+    for (int32 i = 0; i < Num; ++i)
+    {
+        Members.FindOrAdd(Find(i)).Add(i);
+    }
+
+    for (TPair<int32, TArray<int32>>& It : Members)
+    {
+        TArray<int32>& Group = It.Value;
+        if (Group.Num() < 2) continue;
+
+        Group.Sort([&Fps, &Paths](int32 A, int32 B)
+        {
+            const int64 PixA = static_cast<int64>(Fps[A]->Width) * Fps[A]->Height;
+            const int64 PixB = static_cast<int64>(Fps[B]->Width) * Fps[B]->Height;
+            if (PixA != PixB) return PixA > PixB;
+            return Paths[A]->Len() < Paths[B]->Len();
+        });
+
+        FABVDuplicateGroup& G = OutGroups.AddDefaulted_GetRef();
+        for (int32 Idx : Group)
+        {
+            G.AssetPaths.Add(*Paths[Idx]);
+            G.ContentHashes.Add(Fps[Idx]->ContentHash);
+            G.bExact &= (Fps[Idx]->ContentHash == Fps[Group[0]]->ContentHash);
+
+            if (Idx != Group[0])
+            {
+                const EABVTextureKind Kind = FAssetBatchValidatorModule::GuessKindFromName(*Paths[Idx]);
+                G.EstimatedSavingsBytes += ABV_EstimateTextureBytes(Fps[Idx]->Width, Fps[Idx]->Height, Kind);
+            }
+        }
+    }
+
+    OutGroups.Sort([](const FABVDuplicateGroup& A, const FABVDuplicateGroup& B)
+    {
+        return A.EstimatedSavingsBytes > B.EstimatedSavingsBytes;
+    });
+}
@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IO/IoHash.h"
+#include "ABVTypes.h"
+
+struct FAssetData;
+class UTexture2D;
+
+struct FABVTextureFingerprint
+{
+    uint64 ContentHash = 0;      // xxHash64 of mip 0 source bytes + dimensions/format
+    uint64 PerceptualHash = 0;   // 64-bit difference hash of a 9x8 luma thumbnail
+    bool bPerceptualValid = false;   // false for sources smaller than 9x8 or flat: their hash says nothing
+    int32 Width = 0;
+    int32 Height = 0;
+};
+
+// Fingerprints the current mip 0 source of Tex (decodes it). False if the texture has no usable source.
+bool ABV_FingerprintTextureSource(UTexture2D* Tex, FABVTextureFingerprint& Out);
+
+/**
+ * Fingerprints of texture sources, keyed by object path.
+ * Entries are tagged with the package saved-hash they were computed from, so Update() only decodes
+ * textures whose package changed since the cache was written.
+ */
+class FABVTextureHashIndex
+{
+public:
+    static FString GetDefaultCachePath();
+
+    bool LoadCache(const FString& FilePath);
+    bool SaveCache(const FString& FilePath) const;
+
+    // Fingerprints Assets (reusing cached entries) and makes them the current scan set
+    void Update(const TArray<FAssetData>& Assets);
+
+    // Groups the current scan set: equal ContentHash -> exact, Hamming(PerceptualHash) <= NearThreshold -> near
+    void FindGroups(int32 NearThreshold, TArray<FABVDuplicateGroup>& OutGroups) const;
+
+    int32 GetNumHashed() const { return NumHashed; }
+    int32 GetNumReused() const { return NumReused; }
+
+private:
+    struct FEntry
+    {
+        FIoHash PackageHash;
+        FABVTextureFingerprint Fingerprint;
+    };
+
+    TMap<FString, FEntry> Entries;
+    TArray<FString> CurrentScan;
+    int32 NumHashed = 0;
+    int32 NumReused = 0;
+};
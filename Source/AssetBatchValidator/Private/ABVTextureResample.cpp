@@ -0,0 +1,146 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ABVTextureResample.h"
+
+#include "Math/VectorRegister.h"
+
+static constexpr float ABV_LanczosA = 3.0f;
+
+static float ABV_Lanczos(float X)
+{
+    X = FMath::Abs(X);
+    if (X < UE_SMALL_NUMBER) return 1.0f;
+    if (X >= ABV_LanczosA) return 0.0f;
+
+    const float PiX = UE_PI * X;
+    return ABV_LanczosA * FMath::Sin(PiX) * FMath::Sin(PiX / ABV_LanczosA) / (PiX * PiX);
+}
+
+// 只向下取整：修复是缩小 source，不能放大（800 -> 512，而不是 1024）
+static int32 ABV_PowerOfTwoAtMost(int32 X)
+{
+    return static_cast<int32>(FMath::RoundDownToPowerOfTwo(static_cast<uint32>(FMath::Max(1, X))));
+}
+
+bool ABV_ComputeResizeTarget(int32 W, int32 H, int32 MaxSize, bool bMakePowerOfTwo, int32& OutW, int32& OutH)
+{
+    OutW = W;
+    OutH = H;
+    if (W <= 0 || H <= 0) return false;
+
+    if (MaxSize > 0 && FMath::Max(W, H) > MaxSize)
+    {
+        const double Scale = static_cast<double>(MaxSize) / FMath::Max(W, H);
+        OutW = FMath::Max(1, FMath::RoundToInt32(W * Scale));
+        OutH = FMath::Max(1, FMath::RoundToInt32(H * Scale));
+    }
+
+    if (bMakePowerOfTwo)
+    {
+        OutW = ABV_PowerOfTwoAtMost(OutW);
+        OutH = ABV_PowerOfTwoAtMost(OutH);
+    }
+
+    return OutW != W || OutH != H;
+}
+
+namespace
+{
+    // 每个输出像素的 tap 区间和归一化权重
+    struct FABVFilterTaps
+    {
+        TArray<int32> First;
+        TArray<int32> Count;
+        TArray<float> Weights;   // Count[i] weights per output, packed with stride MaxTaps
+        int32 MaxTaps = 0;
+
+        void Build(int32 SrcSize, int32 DstSize)
+        {
+            const float Scale = static_cast<float>(SrcSize) / DstSize;
+            const float FilterScale = FMath::Max(1.0f, Scale);   // 缩小时展宽 kernel 做抗锯齿
+            const float Support = ABV_LanczosA * FilterScale;
+
+            MaxTaps = FMath::CeilToInt32(Support * 2.0f) + 1;
+            First.SetNumUninitialized(DstSize);
+            Count.SetNumUninitialized(DstSize);
+            Weights.SetNumZeroed(DstSize * MaxTaps);
+
+            for (int32 i = 0; i < DstSize; ++i)
+            {
+                const float Center = (i + 0.5f) * Scale - 0.5f;
+                const int32 Lo = FMath::Max(0, FMath::FloorToInt32(Center - Support) + 1);
+                const int32 Hi = FMath::Min(SrcSize - 1, FMath::FloorToInt32(Center + Support));
+
+                float* W = &Weights[i * MaxTaps];
+                float Sum = 0.0f;
+                int32 N = 0;
+                for (int32 s = Lo; s <= Hi && N < MaxTaps; ++s, ++N)
+                {
+                    W[N] = ABV_Lanczos((s - Center) / FilterScale);
+                    Sum += W[N];
+                }
+
+                const float Inv = (FMath::Abs(Sum) > UE_SMALL_NUMBER) ? 1.0f / Sum : 0.0f;
+                for (int32 k = 0; k < N; ++k) W[k] *= Inv;
+
+                First[i] = Lo;
+                Count[i] = N;
+            }
+        }
+    };
+}
+
+void ABV_ResampleLanczos3(const FLinearColor* Src, int32 SrcW, int32 SrcH, FLinearColor* Dst, int32 DstW, int32 DstH)
+{
+    static_assert(sizeof(FLinearColor) == sizeof(float) * 4, "FLinearColor must be 4 packed floats");
+
+    FABVFilterTaps TapsX;
+    FABVFilterTaps TapsY;
+    TapsX.Build(SrcW, DstW);
+    TapsY.Build(SrcH, DstH);
+
+    // 1) horizontal: SrcW x SrcH -> DstW x SrcH
+    TArray64<FLinearColor> Tmp;
+    Tmp.SetNumUninitialized(static_cast<int64>(DstW) * SrcH);
+
+    for (int32 y = 0; y < SrcH; ++y)
+    {
+        const FLinearColor* SrcRow = Src + static_cast<int64>(y) * SrcW;
+        FLinearColor* TmpRow = Tmp.GetData() + static_cast<int64>(y) * DstW;
+
+        for (int32 x = 0; x < DstW; ++x)
+        {
+            const float* W = &TapsX.Weights[x * TapsX.MaxTaps];
+            const FLinearColor* S = SrcRow + TapsX.First[x];
+
+            VectorRegister4Float Acc = VectorZeroFloat();
+            for (int32 k = 0; k < TapsX.Count[x]; ++k)
+            {
+                Acc = VectorMultiplyAdd(VectorLoad(&S[k].R), VectorSetFloat1(W[k]), Acc);
+            }
+            VectorStore(Acc, &TmpRow[x].R);
+        }
+    }
+
+    // 2) vertical: 整行累加，内存顺序访问
+    for (int32 y = 0; y < DstH; ++y)
+    {
+        FLinearColor* DstRow = Dst + static_cast<int64>(y) * DstW;
+        for (int32 x = 0; x < DstW; ++x)
+        {
+            VectorStore(VectorZeroFloat(), &DstRow[x].R);
+        }
+
+        const float* W = &TapsY.Weights[y * TapsY.MaxTaps];
+        for (int32 k = 0; k < TapsY.Count[y]; ++k)
+        {
+            const FLinearColor* TmpRow = Tmp.GetData() + static_cast<int64>(TapsY.First[y] + k) * DstW;
+            const VectorRegister4Float Weight = VectorSetFloat1(W[k]);
+
+            for (int32 x = 0; x < DstW; ++x)
+            {
+                VectorStore(VectorMultiplyAdd(VectorLoad(&TmpRow[x].R), Weight, VectorLoad(&DstRow[x].R)), &DstRow[x].R);
+            }
+        }
+    }
+}
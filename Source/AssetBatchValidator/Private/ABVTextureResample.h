@@ -0,0 +1,16 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Target size for a source resize: fits MaxSize (aspect kept) and optionally rounds each side down to a
+// power of two. Never larger than W x H. Returns false if the source already satisfies both.
+bool ABV_ComputeResizeTarget(int32 W, int32 H, int32 MaxSize, bool bMakePowerOfTwo, int32& OutW, int32& OutH);
+
+/**
+ * Separable Lanczos-3 resample of a linear RGBA32F image.
+ * Weights are precomputed per output row/column; each tap is one 4-wide multiply-add (VectorRegister4Float),
+ * and the vertical pass walks whole rows so both passes stream through memory.
+ */
+void ABV_ResampleLanczos3(const FLinearColor* Src, int32 SrcW, int32 SrcH, FLinearColor* Dst, int32 DstW, int32 DstH);
@@ -0,0 +1,248 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ABVTextureRules.h"
+
+#include "AssetBatchValidator.h"
+#include "Engine/Texture2D.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/Parse.h"
+
+static bool ABV_IsPowerOfTwo(int32 X)
+{
+    return X > 0 && ( (X & (X - 1)) == 0 );
+}
+
+static bool ABV_IsUncompressed(TextureCompressionSettings Compression)
+{
+    return Compression == TC_VectorDisplacementmap
+        || Compression == TC_HDR
+        || Compression == TC_HalfFloat
+        || Compression == TC_SingleFloat
+        || Compression == TC_HDR_F32;
+}
+
+void ABV_GatherTextureFacts(UTexture2D* Tex, const FString& AssetPath, FABVTextureFacts& OutFacts)
+{
+    OutFacts.AssetPath = AssetPath;
+
+    // 用导入源分辨率（不受 streaming 影响）
+    if (Tex->Source.IsValid())
+    {
+        OutFacts.Width = Tex->Source.GetSizeX();
+        OutFacts.Height = Tex->Source.GetSizeY();
+    }
+    else
+    {
+        // 兜底：Source 不可用再用 GetSizeX/Y
+        OutFacts.Width = Tex->GetSizeX();
+        OutFacts.Height = Tex->GetSizeY();
+    }
+
+    OutFacts.Kind = FAssetBatchValidatorModule::GuessKindFromName(AssetPath);
+    OutFacts.bSRGB = Tex->SRGB;
+    OutFacts.CompressionSettings = Tex->CompressionSettings;
+    OutFacts.MipGenSettings = Tex->MipGenSettings;
+    OutFacts.LODGroup = Tex->LODGroup;
+}
+
+template<typename EnumType>
+static void ABV_ParseEnumTag(const FString& Value, EnumType& InOut)
+{
+    const int64 Parsed = StaticEnum<EnumType>()->GetValueByNameString(Value);
+    if (Parsed != INDEX_NONE)
+    {
+        InOut = static_cast<EnumType>(Parsed);
+    }
+}
+
+bool ABV_GatherTextureFactsFromTags(const FString& AssetPath, TFunctionRef<bool(FName, FString&)> FindTag, FABVTextureFacts& OutFacts)
+{
+    OutFacts.AssetPath = AssetPath;
+    OutFacts.Kind = FAssetBatchValidatorModule::GuessKindFromName(AssetPath);
+
+    // "Dimensions" 是 source 尺寸，和 ABV_GatherTextureFacts 一致
+    FString Value;
+    if (!FindTag(TEXT("Dimensions"), Value))
+    {
+        return false;
+    }
+    FString WStr;
+    FString HStr;
+    if (!Value.Split(TEXT("x"), &WStr, &HStr))
+    {
+        return false;
+    }
+    OutFacts.Width = FCString::Atoi(*WStr);
+    OutFacts.Height = FCString::Atoi(*HStr);
+
+    if (FindTag(TEXT("SRGB"), Value))
+    {
+        OutFacts.bSRGB = Value.ToBool();
+    }
+    if (FindTag(TEXT("CompressionSettings"), Value))
+    {
+        ABV_ParseEnumTag(Value, OutFacts.CompressionSettings);
+    }
+    if (FindTag(TEXT("MipGenSettings"), Value))
+    {
+        ABV_ParseEnumTag(Value, OutFacts.MipGenSettings);
+    }
+    if (FindTag(TEXT("LODGroup"), Value))
+    {
+        ABV_ParseEnumTag(Value, OutFacts.LODGroup);
+    }
+    return true;
+}
+
+void ABV_EvaluateTextureFacts(const FABVTextureFacts& Facts, const FABVRuleSettings& Rules, FABVTextureIssue& OutIssue)
+{
+    const int32 W = Facts.Width;
+    const int32 H = Facts.Height;
+    const EABVTextureKind Kind = Facts.Kind;
+
+    // 对当前贴图只生成 1 行
+    EABVIssueSeverity FinalSev = EABVIssueSeverity::OK;
+    TArray<FString> Messages;
+
+    auto AddRule = [&](EABVIssueSeverity Sev, const FString& Msg)
+    {
+        if (static_cast<int32>(Sev) > static_cast<int32>(FinalSev))
+        {
+            FinalSev = Sev;
+        }
+        Messages.Add(Msg);
+    };
+
+    if (Rules.PlatformProfiles.Num() == 0)
+    {
+        // Rule 1: Max Texture Size
+        if (Rules.MaxTextureSize > 0 && (W > Rules.MaxTextureSize || H > Rules.MaxTextureSize))
+        {
+            AddRule(EABVIssueSeverity::Error,
+                FString::Printf(TEXT("Exceeds MaxSize (%d)"), Rules.MaxTextureSize));
+        }
+
+        // Rule 2: Power of Two
+        if (Rules.bCheckPowerOfTwo)
+        {
+            const bool bPOT = ABV_IsPowerOfTwo(W) && ABV_IsPowerOfTwo(H);
+            if (!bPOT)
+            {
+                AddRule(EABVIssueSeverity::Warning, TEXT("Not Power-of-Two"));
+            }
+        }
+    }
+
+    // Normal rules
+    if (Kind == EABVTextureKind::Normal && Rules.bEnableNormalRules)
+    {
+        if (Facts.bSRGB)
+            AddRule(EABVIssueSeverity::Error, TEXT("Normal map should disable sRGB"));
+
+        if (Facts.CompressionSettings != TC_Normalmap)
+            AddRule(EABVIssueSeverity::Warning, TEXT("Normal should use TC_Normalmap"));
+    }
+
+    // ORM/Mask rules
+    if ((Kind == EABVTextureKind::ORM || Kind == EABVTextureKind::Mask) && Rules.bEnableORMRules)
+    {
+        if (Facts.bSRGB)
+            AddRule(EABVIssueSeverity::Error, TEXT("ORM/Mask should disable sRGB"));
+
+        if (Facts.CompressionSettings != TC_Masks)
+            AddRule(EABVIssueSeverity::Warning, TEXT("ORM/Mask should use TC_Masks"));
+    }
+
+    // -------------------------
+    // Optional: MipGen / LODGroup (先占位)
+    // -------------------------
+    if (Rules.bCheckMipGen)
+    {
+        // 你之后可以在这里检查 Facts.MipGenSettings
+    }
+
+    if (Rules.bCheckLODGroup)
+    {
+        // 你之后可以在这里检查 Facts.LODGroup
+    }
+
+    // Platform profiles: 同一份 Facts，逐平台评估
+    OutIssue.PlatformResults.Reset();
+    for (const FABVPlatformProfile& Profile : Rules.PlatformProfiles)
+    {
+        FABVPlatformResult& PR = OutIssue.PlatformResults.AddDefaulted_GetRef();
+        PR.Platform = Profile.Name;
+
+        TArray<FString> PlatformMessages;
+        auto AddPlatformRule = [&](EABVIssueSeverity Sev, const FString& Msg)
+        {
+            if (static_cast<int32>(Sev) > static_cast<int32>(PR.Severity))
+            {
+                PR.Severity = Sev;
+            }
+            PlatformMessages.Add(Msg);
+        };
+
+        if (Profile.MaxTextureSize > 0 && (W > Profile.MaxTextureSize || H > Profile.MaxTextureSize))
+        {
+            AddPlatformRule(EABVIssueSeverity::Error,
+                FString::Printf(TEXT("Exceeds MaxSize (%d)"), Profile.MaxTextureSize));
+        }
+
+        if (Profile.bRequirePowerOfTwo && !(ABV_IsPowerOfTwo(W) && ABV_IsPowerOfTwo(H)))
+        {
+            AddPlatformRule(EABVIssueSeverity::Warning, TEXT("Not Power-of-Two"));
+        }
+
+        if (!Profile.bAllowUncompressed && ABV_IsUncompressed(Facts.CompressionSettings))
+        {
+            AddPlatformRule(EABVIssueSeverity::Error, TEXT("Uncompressed format not allowed"));
+        }
+
+        PR.Message = (PlatformMessages.Num() == 0) ? TEXT("OK") : FString::Join(PlatformMessages, TEXT(" | "));
+        if (PlatformMessages.Num() > 0)
+        {
+            AddRule(PR.Severity, FString::Printf(TEXT("[%s] %s"), *Profile.Name.ToString(), *PR.Message));
+        }
+    }
+
+    OutIssue.AssetPath = Facts.AssetPath;
+    OutIssue.Width = W;
+    OutIssue.Height = H;
+    OutIssue.Kind = Kind;
+    OutIssue.Severity = FinalSev;
+    OutIssue.Message = (Messages.Num() == 0)
+        ? TEXT("OK")
+        : FString::Join(Messages, TEXT(" | "));
+    OutIssue.bCanFix =
+        (Kind == EABVTextureKind::Normal
+      || Kind == EABVTextureKind::ORM
+      || Kind == EABVTextureKind::Mask);
+}
+
+void ABV_LoadPlatformProfiles(const FString& IniFile, TArray<FABVPlatformProfile>& OutProfiles)
+{
+    OutProfiles.Reset();
+
+    TArray<FString> Entries;
+    GConfig->GetArray(TEXT("AssetBatchValidator"), TEXT("PlatformProfiles"), Entries, IniFile);
+
+    for (const FString& Entry : Entries)
+    {
+        FABVPlatformProfile Profile;
+        FString Name;
+        if (!FParse::Value(*Entry, TEXT("Name="), Name))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ABV: Platform profile without Name ignored: %s"), *Entry);
+            continue;
+        }
+        Name.RemoveFromEnd(TEXT(")"));
+        Profile.Name = FName(*Name);
+
+        FParse::Value(*Entry, TEXT("MaxTextureSize="), Profile.MaxTextureSize);
+        FParse::Bool(*Entry, TEXT("bRequirePowerOfTwo="), Profile.bRequirePowerOfTwo);
+        FParse::Bool(*Entry, TEXT("bAllowUncompressed="), Profile.bAllowUncompressed);
+
+        OutProfiles.Add(Profile);
+    }
+}
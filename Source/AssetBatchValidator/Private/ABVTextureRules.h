@@ -0,0 +1,35 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/TextureDefines.h"
+#include "ABVTypes.h"
+
+class UTexture2D;
+
+// Everything the rules look at, gathered once per texture and shared by all platform profiles
+struct FABVTextureFacts
+{
+    FString AssetPath;
+    int32 Width = 0;
+    int32 Height = 0;
+    EABVTextureKind Kind = EABVTextureKind::Unknown;
+
+    bool bSRGB = true;
+    TextureCompressionSettings CompressionSettings = TC_Default;
+    TextureMipGenSettings MipGenSettings = TMGS_FromTextureGroup;
+    TextureGroup LODGroup = TEXTUREGROUP_World;
+};
+
+void ABV_GatherTextureFacts(UTexture2D* Tex, const FString& AssetPath, FABVTextureFacts& OutFacts);
+
+// Same facts from asset registry tags ("Dimensions", "SRGB", "CompressionSettings", ...), without loading the texture.
+// FindTag returns false if the tag is missing. Returns false if the dimensions tag is missing or malformed.
+bool ABV_GatherTextureFactsFromTags(const FString& AssetPath, TFunctionRef<bool(FName /*Tag*/, FString& /*OutValue*/)> FindTag, FABVTextureFacts& OutFacts);
+
+// Evaluates the kind rules once and size/format rules per platform profile
+void ABV_EvaluateTextureFacts(const FABVTextureFacts& Facts, const FABVRuleSettings& Rules, FABVTextureIssue& OutIssue);
+
+// Reads [AssetBatchValidator] +PlatformProfiles=(Name=...,MaxTextureSize=...,bRequirePowerOfTwo=...,bAllowUncompressed=...)
+void ABV_LoadPlatformProfiles(const FString& IniFile, TArray<FABVPlatformProfile>& OutProfiles);
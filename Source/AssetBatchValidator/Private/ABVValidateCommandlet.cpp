@@ -0,0 +1,272 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ABVValidateCommandlet.h"
+
+#include "AssetBatchValidator.h"
+#include "ABVOfflineScanner.h"
+#include "ABVMemoryTracker.h"
+#include "ABVSharedCache.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/Parse.h"
+#include "Modules/ModuleManager.h"
+
+#include <stdio.h>
+
+UABVValidateCommandlet::UABVValidateCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+static void ABV_ReadStdinLines(TArray<FString>& OutLines)
+{
+    auto AddLine = [&OutLines](TArray<ANSICHAR>& Bytes)
+    {
+        FString Line(FUTF8ToTCHAR(Bytes.GetData(), Bytes.Num()));
+        Bytes.Reset();
+        Line.TrimStartAndEndInline();
+        if (!Line.IsEmpty())
+        {
+            OutLines.Add(MoveTemp(Line));
+        }
+    };
+
+    // 一行可能比缓冲区长，拼到换行为止
+    char Buffer[2048];
+    TArray<ANSICHAR> Pending;
+    while (fgets(Buffer, sizeof(Buffer), stdin) != nullptr)
+    {
+        const int32 Len = FCStringAnsi::Strlen(Buffer);
+        const bool bEndOfLine = Len > 0 && Buffer[Len - 1] == '\n';
+        Pending.Append(Buffer, bEndOfLine ? Len - 1 : Len);
+        if (bEndOfLine)
+        {
+            AddLine(Pending);
+        }
+    }
+    if (Pending.Num() > 0)
+    {
+        AddLine(Pending);
+    }
+}
+
+// Mount point ("/Game/", "/MyPlugin/") whose content directory is ContentDir; empty if none matches
+static FString ABV_FindMountPointForContentDir(const FString& ContentDir)
+{
+    FString Dir = FPaths::ConvertRelativePathToFull(ContentDir);
+    FPaths::NormalizeDirectoryName(Dir);
+
+    TArray<FString> RootPaths;
+    FPackageName::QueryRootContentPaths(RootPaths);
+    for (const FString& Root : RootPaths)
+    {
+        FString RootDir = FPaths::ConvertRelativePathToFull(FPackageName::LongPackageNameToFilename(Root));
+        FPaths::NormalizeDirectoryName(RootDir);
+        if (FPaths::IsSamePath(RootDir, Dir))
+        {
+            return Root;
+        }
+    }
+    return FString();
+}
+
+// Runs the in-editor scan over the same mount point and reports every texture whose offline result differs
+static int32 ABV_VerifyAgainstRegistry(FAssetBatchValidatorModule& Mod, const FABVRuleSettings& Rules, const FString& MountPoint, const TArray<FABVTextureIssue>& OfflineIssues)
+{
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    AssetRegistry.SearchAllAssets(/*bSynchronousSearch=*/true);
+
+    FString RootPath = MountPoint;
+    RootPath.RemoveFromEnd(TEXT("/"));
+
+    TArray<FABVTextureIssue> EditorIssues;
+    Mod.ValidateTextures(FName(*RootPath), /*bRecursive=*/true, Rules, EditorIssues);
+
+    TArray<FString> Mismatches;
+    const int32 NumMismatches = FABVOfflineScanner::CompareWithEditor(EditorIssues, OfflineIssues, Mismatches);
+    for (const FString& Mismatch : Mismatches)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ABV Verify: %s"), *Mismatch);
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("ABV Verify: %d editor results, %d mismatches"), EditorIssues.Num(), NumMismatches);
+    return NumMismatches;
+}
+
+int32 UABVValidateCommandlet::Main(const FString& Params)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    FAssetBatchValidatorModule& Mod =
+        FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+    FABVRuleSettings Rules;
+    FParse::Value(*Params, TEXT("MaxSize="), Rules.MaxTextureSize);
+    Rules.bCheckPowerOfTwo = !FParse::Param(*Params, TEXT("NoPOT"));
+    if (FParse::Param(*Params, TEXT("Profiles")))
+    {
+        Rules.PlatformProfiles = Mod.GetPlatformProfiles();
+    }
+
+    FABVScanLimits Limits;
+    FParse::Value(*Params, TEXT("MaxErrors="), Limits.MaxErrors);
+    FParse::Value(*Params, TEXT("TimeBudget="), Limits.TimeBudgetSeconds);
+
+    FString SharedCacheDir;
+    if (FParse::Value(*Params, TEXT("SharedCache="), SharedCacheDir))
+    {
+        int32 SharedCacheMaxMB = 10240;
+        FParse::Value(*Params, TEXT("SharedCacheMaxMB="), SharedCacheMaxMB);
+        Mod.SetSharedCacheDirectory(SharedCacheDir, static_cast<int64>(FMath::Max(SharedCacheMaxMB, 0)) * 1024 * 1024);
+    }
+
+    int32 MemoryBudgetMB = 0;
+    if (FParse::Value(*Params, TEXT("MemoryBudgetMB="), MemoryBudgetMB))
+    {
+        FABVMemoryTracker::Get().SetBudgetBytes(static_cast<uint64>(FMath::Max(MemoryBudgetMB, 0)) * 1024 * 1024);
+    }
+
+    // ---------- Collect changed files ----------
+    TArray<FString> ChangedFiles;
+    bool bChangeListMode = false;
+
+    FString FilesArg;
+    if (FParse::Value(*Params, TEXT("Files="), FilesArg, /*bShouldStopOnSeparator=*/false))
+    {
+        FilesArg.ParseIntoArray(ChangedFiles, TEXT("+"));
+        bChangeListMode = true;
+    }
+
+    FString FileListPath;
+    if (FParse::Value(*Params, TEXT("FileList="), FileListPath))
+    {
+        TArray<FString> Lines;
+        if (!FFileHelper::LoadFileToStringArray(Lines, *FileListPath))
+        {
+            UE_LOG(LogTemp, Error, TEXT("ABV: Cannot read file list %s"), *FileListPath);
+            return 2;
+        }
+        ChangedFiles.Append(Lines);
+        bChangeListMode = true;
+    }
+
+    if (FParse::Param(*Params, TEXT("Stdin")))
+    {
+        ABV_ReadStdinLines(ChangedFiles);
+        bChangeListMode = true;
+    }
+
+    FString DiffBase;
+    if (FParse::Param(*Params, TEXT("Git")) || FParse::Value(*Params, TEXT("Git="), DiffBase))
+    {
+        TArray<FString> GitFiles;
+        if (!Mod.GatherGitChangedFiles(DiffBase, GitFiles))
+        {
+            return 2;
+        }
+        ChangedFiles.Append(GitFiles);
+        bChangeListMode = true;
+    }
+
+    // ---------- Validate ----------
+    TArray<FABVTextureIssue> Issues;
+    int32 NumMismatches = 0;
+    bool bComplete = true;
+    if (FParse::Param(*Params, TEXT("Offline")))
+    {
+        FString ContentDir = FPaths::ProjectContentDir();
+        FString MountPoint = TEXT("/Game/");
+        if (FParse::Value(*Params, TEXT("ContentDir="), ContentDir) && !FParse::Value(*Params, TEXT("MountPoint="), MountPoint))
+        {
+            // 插件等其它内容目录：包名和 -Verify 的 registry 根都用它自己的挂载点
+            MountPoint = ABV_FindMountPointForContentDir(ContentDir);
+            if (MountPoint.IsEmpty())
+            {
+                UE_LOG(LogTemp, Error, TEXT("ABV: %s is not a mounted content directory, pass -MountPoint=/<Name>/"), *ContentDir);
+                return 2;
+            }
+        }
+        if (!MountPoint.EndsWith(TEXT("/")))
+        {
+            MountPoint += TEXT("/");
+        }
+
+        bComplete = FABVOfflineScanner::ScanDirectory(ContentDir, MountPoint, Rules, Issues, Limits);
+
+        if (FParse::Param(*Params, TEXT("Verify")))
+        {
+            NumMismatches = ABV_VerifyAgainstRegistry(Mod, Rules, MountPoint, Issues);
+        }
+    }
+    else if (bChangeListMode)
+    {
+        // 只扫描改动的文件，不做全量 SearchAllAssets
+        TArray<FString> AbsFiles;
+        for (const FString& File : ChangedFiles)
+        {
+            const FString Trimmed = File.TrimStartAndEnd();
+            if (Trimmed.IsEmpty()) continue;
+            AbsFiles.Add(FPaths::ConvertRelativePathToFull(FPaths::IsRelative(Trimmed) ? FPaths::ProjectDir() / Trimmed : Trimmed));
+        }
+        AssetRegistry.ScanFilesSynchronous(AbsFiles);
+
+        // 改动集合小，只有设置了 fail-fast 时才值得为排序 stat 每个文件
+        Limits.bImpactOrder = Limits.MaxErrors > 0 || Limits.TimeBudgetSeconds > 0.0;
+        bComplete = Mod.ValidateChangedFiles(AbsFiles, Rules, Issues, Limits);
+    }
+    else
+    {
+        FString Root = TEXT("/Game");
+        FParse::Value(*Params, TEXT("Root="), Root);
+
+        AssetRegistry.SearchAllAssets(/*bSynchronousSearch=*/true);
+        Limits.bImpactOrder = true;
+        bComplete = Mod.ValidateTextures(FName(*Root), /*bRecursive=*/true, Rules, Issues, Limits);
+    }
+
+    // ---------- Summary ----------
+    int32 NumErrors = 0;
+    int32 NumWarnings = 0;
+    for (const FABVTextureIssue& I : Issues)
+    {
+        if (I.Severity == EABVIssueSeverity::Error) NumErrors++;
+        else if (I.Severity == EABVIssueSeverity::Warning) NumWarnings++;
+
+        if (I.Severity != EABVIssueSeverity::OK)
+        {
+            UE_LOG(LogTemp, Display, TEXT("ABV: %s %s"), *I.AssetPath, *I.Message);
+        }
+    }
+
+    FString ReportPath;
+    if (FParse::Value(*Params, TEXT("Report="), ReportPath))
+    {
+        Mod.ExportReportCSV(Issues, ReportPath);
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("ABV: %d textures, %d errors, %d warnings (%.1f ms total)%s"),
+        Issues.Num(), NumErrors, NumWarnings, (FPlatformTime::Seconds() - StartTime) * 1000.0,
+        bComplete ? TEXT("") : TEXT(" [PARTIAL: fail-fast limit reached]"));
+    UE_LOG(LogTemp, Display, TEXT("ABV: Memory %s"), *FABVMemoryTracker::Get().GetSummary());
+    if (FABVSharedCache* SharedCache = Mod.GetSharedCache())
+    {
+        // 命令行一次跑完，结束时同步淘汰一次
+        SharedCache->Evict();
+        UE_LOG(LogTemp, Display, TEXT("ABV: Shared cache %s: %d hits, %d misses, %d written"),
+            *SharedCache->GetDirectory(), SharedCache->GetNumHits(), SharedCache->GetNumMisses(), SharedCache->GetNumPuts());
+    }
+
+    if (NumMismatches > 0)
+    {
+        return 3;
+    }
+    return NumErrors > 0 ? 1 : 0;
+}
@@ -0,0 +1,39 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ABVValidateCommandlet.generated.h"
+
+/**
+ * Headless texture validation for CI / pre-submit.
+ *
+ *   -run=ABVValidate -Root=/Game/Textures            full folder scan
+ *   -run=ABVValidate -Git[=<DiffBase>]               files changed in the local git diff
+ *   -run=ABVValidate -Files=A.uasset+B.uasset        explicit file list
+ *   -run=ABVValidate -FileList=Changed.txt           one file per line
+ *   -run=ABVValidate -Stdin                          one file per line on stdin (git diff --name-only | ...)
+ *   -run=ABVValidate -Offline [-ContentDir=<dir>]    read .uasset headers directly, no asset registry
+ *                    [-MountPoint=/<Name>/]          package root of ContentDir (default: looked up from the mounted roots)
+ *                    [-Verify]                       ...and diff against the in-editor scan of the same mount point
+ *
+ * Optional: -MaxSize=2048 -NoPOT -Profiles -Report=<csv path>
+ * Fail-fast: -MaxErrors=<N> -TimeBudget=<seconds> apply to every mode. Registry scans visit textures worst-first
+ * (-Offline visits files in parallel, without impact order); the report written so far is still valid, just
+ * marked partial in the summary.
+ * -Profiles evaluates every [AssetBatchValidator] PlatformProfiles entry in the same pass.
+ * -SharedCache=<dir> [-SharedCacheMaxMB=<N>] reads/populates a shared team result cache (overrides ini / ABV_SHARED_CACHE).
+ * -MemoryBudgetMB=<N> overrides the ini budget; batches shrink and GC runs when a run exceeds it.
+ * Returns 1 if any texture has an Error, 3 if -Verify found mismatches, 0 otherwise.
+ */
+UCLASS()
+class UABVValidateCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UABVValidateCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
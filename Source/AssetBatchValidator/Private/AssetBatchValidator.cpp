@@ -14,13 +14,26 @@
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/PackageName.h"
+#include "ObjectTools.h"
+#include "ABVTextureHashing.h"
+#include "ABVTextureRules.h"
+#include "ABVTextureResample.h"
+#include "ABVScheduler.h"
+#include "Async/ParallelFor.h"
+#include "ImageCore.h"
+#include "ABVMemoryTracker.h"
+#include "ABVTaskExecutor.h"
+#include "Tasks/Task.h"
+#include "ABVSharedCache.h"
+#include "ABVChannelPacking.h"
+#include "ABVSourceWatcher.h"
+#include "ABVResultsCache.h"
+#include "UObject/Package.h"
 
 #define LOCTEXT_NAMESPACE "FAssetBatchValidatorModule"
-static bool ABV_IsPowerOfTwo(int32 X)
-{
-    return X > 0 && ( (X & (X - 1)) == 0 );
-}
-
 static bool ABV_HasToken(const FString& Name, const FString& Token)
 {
     const FString T = TEXT("_") + Token;
@@ -132,8 +145,24 @@ void FAssetBatchValidatorModule::ValidateTextures(
     bool bCheckLODGroup,
     TArray<FABVTextureIssue>& OutIssues)
 {
-    OutIssues.Reset();
+    FABVRuleSettings Rules;
+    Rules.MaxTextureSize = MaxTextureSize;
+    Rules.bCheckPowerOfTwo = bCheckPowerOfTwo;
+    Rules.bEnableNormalRules = bEnableNormalRules;
+    Rules.bEnableORMRules = bEnableORMRules;
+    Rules.bCheckMipGen = bCheckMipGen;
+    Rules.bCheckLODGroup = bCheckLODGroup;
+
+    ValidateTextures(RootPath, bRecursive, Rules, OutIssues);
+}
 
+bool FAssetBatchValidatorModule::ValidateTextures(
+    const FName& RootPath,
+    bool bRecursive,
+    const FABVRuleSettings& Rules,
+    TArray<FABVTextureIssue>& OutIssues,
+    const FABVScanLimits& Limits)
+{
     IAssetRegistry& AssetRegistry =
         FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
 
@@ -142,117 +171,391 @@ void FAssetBatchValidatorModule::ValidateTextures(
     Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
     Filter.bRecursivePaths = bRecursive;
 
+    if (AssetRegistry.IsLoadingAssets())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ABV: Asset registry is still discovering assets, results will be partial. Use FABVStreamingScan instead."));
+    }
+
     TArray<FAssetData> Assets;
     AssetRegistry.GetAssets(Filter, Assets);
 
     UE_LOG(LogTemp, Display, TEXT("=== ABV: Validate Textures in %s (%d found) ==="),
         *RootPath.ToString(), Assets.Num());
 
-    for (const FAssetData& AD : Assets)
+    return ValidateAssets(Assets, Rules, OutIssues, Limits);
+}
+
+bool FAssetBatchValidatorModule::ValidateAssets(
+    const TArray<FAssetData>& InAssets,
+    const FABVRuleSettings& Rules,
+    TArray<FABVTextureIssue>& OutIssues,
+    const FABVScanLimits& Limits)
+{
+    OutIssues.Reset();
+    OutIssues.Reserve(InAssets.Num());
+
+    // 最严重的先验证：fail-fast 提前停止时，报告里也已经包含了最重要的问题
+    TArray<FAssetData> Sorted;
+    const bool bSort = Limits.bImpactOrder && InAssets.Num() > 1;
+    if (bSort)
     {
-        UTexture2D* Tex = Cast<UTexture2D>(AD.GetAsset());
-        if (!Tex) continue;
+        Sorted = InAssets;
+        ABV_SortAssetsByImpact(Sorted, Rules);
+    }
+    const TArray<FAssetData>& Assets = bSort ? Sorted : InAssets;
+
+    ABV_LLM_SCOPE();
+    FABVScopedMemoryPhase MemoryPhase(TEXT("Validate"));
+    FABVMemoryTracker& Memory = FABVMemoryTracker::Get();
 
-        const FString AssetPath = AD.GetObjectPathString();
-        int32 W = 0;
-        int32 H = 0;
+    // 每批结束检查内存预算，超出则释放本次加载的贴图并缩小批大小
+    constexpr int32 MaxBatchSize = FABVMemoryTracker::MaxScanLoads;
+    int32 BatchSize = MaxBatchSize;
+    int32 NumInBatch = 0;
 
-        // 用导入源分辨率（不受 streaming 影响）
-        if (Tex->Source.IsValid())
+    const double StartTime = FPlatformTime::Seconds();
+    int32 NumErrors = 0;
+
+    const FIoHash RulesFingerprint = SharedCache.IsValid() ? FABVSharedCache::ComputeRulesFingerprint(Rules) : FIoHash::Zero;
+
+    for (int32 Index = 0; Index < Assets.Num(); ++Index)
+    {
+        FABVTextureIssue& Issue = OutIssues.AddDefaulted_GetRef();
+        if (!ValidateAsset(Assets[Index], Rules, RulesFingerprint, Issue))
         {
-            W = Tex->Source.GetSizeX();
-            H = Tex->Source.GetSizeY();
+            OutIssues.Pop(EAllowShrinking::No);
+            continue;
         }
-        else
+
+        NumErrors += (Issue.Severity == EABVIssueSeverity::Error) ? 1 : 0;
+
+        if (++NumInBatch >= BatchSize)
         {
-            // 兜底：Source 不可用再用 GetSizeX/Y
-            W = Tex->GetSizeX();
-            H = Tex->GetSizeY();
-        }        
+            BatchSize = Memory.AdaptBatchSize(BatchSize, 16, MaxBatchSize);
+            NumInBatch = 0;
+        }
+        // 同时持有的新加载贴图不超过一批
+        Memory.ReleaseScanLoads(BatchSize);
 
-        const EABVTextureKind Kind = ABV_GuessKindFromName(AssetPath);
+        const bool bHitErrorLimit = Limits.MaxErrors > 0 && NumErrors >= Limits.MaxErrors;
+        const bool bHitTimeLimit = Limits.TimeBudgetSeconds > 0.0 && (FPlatformTime::Seconds() - StartTime) >= Limits.TimeBudgetSeconds;
+        if ((bHitErrorLimit || bHitTimeLimit) && Index + 1 < Assets.Num())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ABV: Fail-fast (%s) after %d of %d textures, result is partial"),
+                bHitErrorLimit ? TEXT("error limit") : TEXT("time budget"), Index + 1, Assets.Num());
+            Memory.ReleaseScanLoads();
+            return false;
+        }
+    }
 
-        // 对当前贴图只生成 1 行
-        EABVIssueSeverity FinalSev = EABVIssueSeverity::OK;
-        TArray<FString> Messages;
+    Memory.ReleaseScanLoads();
 
-        auto AddRule = [&](EABVIssueSeverity Sev, const FString& Msg)
+    // 淘汰在后台任务里跑，不在这里遍历共享目录
+    if (SharedCache.IsValid())
+    {
+        SharedCache->EvictIfNeeded();
+    }
+    return true;
+}
+
+bool FAssetBatchValidatorModule::ValidateAsset(
+    const FAssetData& AD,
+    const FABVRuleSettings& Rules,
+    const FIoHash& RulesFingerprint,
+    FABVTextureIssue& OutIssue)
+{
+    const FString ObjectPath = AD.GetObjectPathString();
+
+    // 共享缓存命中则不加载贴图；未保存的修改以内存为准，不走缓存
+    FIoHash PackageHash = FIoHash::Zero;
+    if (SharedCache.IsValid())
+    {
+        const UPackage* LoadedPackage = FindObject<UPackage>(nullptr, *AD.PackageName.ToString());
+        if (!LoadedPackage || !LoadedPackage->IsDirty())
         {
-            if (static_cast<int32>(Sev) > static_cast<int32>(FinalSev))
+            PackageHash = ABV_GetPackageSavedHash(ObjectPath);
+        }
+    }
+
+    if (!PackageHash.IsZero() && SharedCache->Get(ObjectPath, PackageHash, RulesFingerprint, OutIssue))
+    {
+        return true;
+    }
+
+    // 只为验证而加载的贴图登记下来，由扫描循环成批释放；之前就在内存里的不动
+    const bool bWasLoaded = AD.IsAssetLoaded();
+    UTexture2D* Tex = Cast<UTexture2D>(AD.GetAsset());
+    if (!Tex)
+    {
+        return false;
+    }
+    if (!bWasLoaded)
+    {
+        FABVMemoryTracker::Get().TrackScanLoad(Tex);
+    }
+
+    // 一次取齐数据，所有平台 profile 共用
+    FABVTextureFacts Facts;
+    ABV_GatherTextureFacts(Tex, ObjectPath, Facts);
+    OutIssue = FABVTextureIssue();
+    ABV_EvaluateTextureFacts(Facts, Rules, OutIssue);
+
+    if (!PackageHash.IsZero())
+    {
+        SharedCache->Put(ObjectPath, PackageHash, RulesFingerprint, OutIssue);
+    }
+    return true;
+}
+
+void FAssetBatchValidatorModule::SetSharedCacheDirectory(const FString& Directory, int64 MaxBytes)
+{
+    if (Directory.IsEmpty())
+    {
+        SharedCache.Reset();
+        return;
+    }
+
+    SharedCache = MakeShared<FABVSharedCache>(Directory, MaxBytes);
+    UE_LOG(LogTemp, Display, TEXT("ABV: Shared validation cache at %s (max %.0f MB)"), *Directory, MaxBytes / (1024.0 * 1024.0));
+}
+
+void FAssetBatchValidatorModule::StartSourceWatcher()
+{
+    bool bWatchImportSources = true;
+    bool bReimportChangedSources = false;
+    GConfig->GetBool(TEXT("AssetBatchValidator"), TEXT("bWatchImportSources"), bWatchImportSources, GEditorIni);
+    GConfig->GetBool(TEXT("AssetBatchValidator"), TEXT("bReimportChangedSources"), bReimportChangedSources, GEditorIni);
+    if (!bWatchImportSources || IsRunningCommandlet())
+    {
+        return;
+    }
+
+    SourceWatcher = MakeShared<FABVSourceWatcher>(bReimportChangedSources);
+    SourceWatcher->OnSourcesChanged.BindLambda([this](const TArray<FString>& AssetPaths, bool bReimported)
+    {
+        SourcesChangedEvent.Broadcast(AssetPaths, bReimported);
+    });
+
+    // 反向索引需要完整的 registry，启动时等扫描结束
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    if (AssetRegistry.IsLoadingAssets())
+    {
+        FilesLoadedHandle = AssetRegistry.OnFilesLoaded().AddLambda([this]()
+        {
+            if (SourceWatcher.IsValid())
             {
-                FinalSev = Sev;
+                SourceWatcher->Start();
             }
-            Messages.Add(Msg);
-        };
+        });
+    }
+    else
+    {
+        SourceWatcher->Start();
+    }
+}
+
+void FAssetBatchValidatorModule::LoadSharedCacheSettings()
+{
+    FString Directory;
+    int32 MaxMB = 10240;
+    GConfig->GetString(TEXT("AssetBatchValidator"), TEXT("SharedCacheDir"), Directory, GEditorIni);
+    GConfig->GetInt(TEXT("AssetBatchValidator"), TEXT("SharedCacheMaxMB"), MaxMB, GEditorIni);
+
+    // 环境变量优先，和 UE-SharedDataCachePath 一样方便在 CI 机器上覆盖
+    const FString EnvDirectory = FPlatformMisc::GetEnvironmentVariable(TEXT("ABV_SHARED_CACHE"));
+    if (!EnvDirectory.IsEmpty())
+    {
+        Directory = EnvDirectory;
+    }
 
-        // Rule 1: Max Texture Size
-        if (MaxTextureSize > 0 && (W > MaxTextureSize || H > MaxTextureSize))
+    SetSharedCacheDirectory(Directory, static_cast<int64>(FMath::Max(MaxMB, 0)) * 1024 * 1024);
+}
+
+void FAssetBatchValidatorModule::ConvertFilesToPackageNames(const TArray<FString>& Files, TArray<FName>& OutPackageNames)
+{
+    OutPackageNames.Reset();
+
+    TSet<FName> Seen;
+    for (FString File : Files)
+    {
+        File.TrimStartAndEndInline();
+        if (File.IsEmpty()) continue;
+
+        const FString Ext = FPaths::GetExtension(File, /*bIncludeDot=*/true);
+        if (Ext != FPackageName::GetAssetPackageExtension() && Ext != FPackageName::GetMapPackageExtension())
         {
-            AddRule(EABVIssueSeverity::Error,
-                FString::Printf(TEXT("Exceeds MaxSize (%d)"), MaxTextureSize));
+            continue; // source code, configs, raw art etc.
         }
 
-        // Rule 2: Power of Two
-        if (bCheckPowerOfTwo)
+        // git 输出是相对项目目录的路径
+        if (FPaths::IsRelative(File))
         {
-            const bool bPOT = ABV_IsPowerOfTwo(W) && ABV_IsPowerOfTwo(H);
-            if (!bPOT)
-            {
-                AddRule(EABVIssueSeverity::Warning, TEXT("Not Power-of-Two"));
-            }
+            File = FPaths::ProjectDir() / File;
         }
+        File = FPaths::ConvertRelativePathToFull(File);
 
-        // Normal rules
-        if (Kind == EABVTextureKind::Normal && bEnableNormalRules)
+        FString PackageName;
+        FString Reason;
+        if (!FPackageName::TryConvertFilenameToLongPackageName(File, PackageName, &Reason))
         {
-            if (Tex->SRGB)
-                AddRule(EABVIssueSeverity::Error, TEXT("Normal map should disable sRGB"));
+            UE_LOG(LogTemp, Verbose, TEXT("ABV: Skip %s (%s)"), *File, *Reason);
+            continue;
+        }
 
-            if (Tex->CompressionSettings != TC_Normalmap)
-                AddRule(EABVIssueSeverity::Warning, TEXT("Normal should use TC_Normalmap"));
+        const FName PkgName(*PackageName);
+        if (!Seen.Contains(PkgName))
+        {
+            Seen.Add(PkgName);
+            OutPackageNames.Add(PkgName);
         }
+    }
+}
+
+// git 对含特殊字符的路径输出 C 风格的带引号字符串（"a\tb", "\346\265..."），还原成原始 UTF-8 路径
+static FString ABV_UnquoteGitPath(const FString& Line)
+{
+    if (Line.Len() < 2 || !Line.StartsWith(TEXT("\"")) || !Line.EndsWith(TEXT("\"")))
+    {
+        return Line;
+    }
 
-        // ORM/Mask rules
-        if ((Kind == EABVTextureKind::ORM || Kind == EABVTextureKind::Mask) && bEnableORMRules)
+    TArray<ANSICHAR> Bytes;
+    for (int32 i = 1; i < Line.Len() - 1; ++i)
+    {
+        const TCHAR C = Line[i];
+        if (C != TEXT('\\') || i + 1 >= Line.Len() - 1)
         {
-            if (Tex->SRGB)
-                AddRule(EABVIssueSeverity::Error, TEXT("ORM/Mask should disable sRGB"));
+            const FTCHARToUTF8 Utf8(&Line[i], 1);
+            Bytes.Append(Utf8.Get(), Utf8.Length());
+            continue;
+        }
 
-            if (Tex->CompressionSettings != TC_Masks)
-                AddRule(EABVIssueSeverity::Warning, TEXT("ORM/Mask should use TC_Masks"));
+        const TCHAR Next = Line[++i];
+        if (Next >= TEXT('0') && Next <= TEXT('7'))
+        {
+            // 三位八进制，一个字节
+            int32 Value = 0;
+            int32 NumDigits = 0;
+            for (; NumDigits < 3 && i < Line.Len() - 1 && Line[i] >= TEXT('0') && Line[i] <= TEXT('7'); ++NumDigits, ++i)
+            {
+                Value = Value * 8 + (Line[i] - TEXT('0'));
+            }
+            --i;
+            Bytes.Add(static_cast<ANSICHAR>(Value));
         }
+        else
+        {
+            switch (Next)
+            {
+            case TEXT('t'): Bytes.Add('\t'); break;
+            case TEXT('n'): Bytes.Add('\n'); break;
+            case TEXT('r'): Bytes.Add('\r'); break;
+            default:        Bytes.Add(static_cast<ANSICHAR>(Next)); break;   // \\ 和 \"
+            }
+        }
+    }
+    return FString(FUTF8ToTCHAR(Bytes.GetData(), Bytes.Num()));
+}
+
+bool FAssetBatchValidatorModule::GatherGitChangedFiles(const FString& DiffBase, TArray<FString>& OutFiles) const
+{
+    OutFiles.Reset();
 
-        // -------------------------
-        // Optional: MipGen / LODGroup (先占位)
-        // -------------------------
-        if (bCheckMipGen)
+    const FString WorkDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+
+    auto RunGit = [&WorkDir, &OutFiles](const FString& Args) -> bool
+    {
+        int32 ReturnCode = -1;
+        FString StdOut;
+        FString StdErr;
+        if (!FPlatformProcess::ExecProcess(TEXT("git"), *Args, &ReturnCode, &StdOut, &StdErr, *WorkDir) || ReturnCode != 0)
         {
-            // 你之后可以在这里检查 Tex->MipGenSettings
-            // ABV_AddIssue(..., TEXT("MipGenSettings not expected ..."));
+            UE_LOG(LogTemp, Warning, TEXT("ABV: git %s failed (%d): %s"), *Args, ReturnCode, *StdErr);
+            return false;
         }
 
-        if (bCheckLODGroup)
+        TArray<FString> Lines;
+        StdOut.ParseIntoArrayLines(Lines);
+        for (const FString& Line : Lines)
         {
-            // 你之后可以在这里检查 Tex->LODGroup
-            // ABV_AddIssue(..., TEXT("LODGroup not expected ..."));
+            OutFiles.Add(ABV_UnquoteGitPath(Line));
         }
-        
-        const FString FinalMsg = (Messages.Num() == 0)
-            ? TEXT("OK")
-            : FString::Join(Messages, TEXT(" | "));
+        return true;
+    };
 
-        const bool bCanFix =
-            (Kind == EABVTextureKind::Normal
-          || Kind == EABVTextureKind::ORM
-          || Kind == EABVTextureKind::Mask);
-        
-        ABV_AddIssue(OutIssues, AssetPath, W, H, Kind, FinalSev, FinalMsg, bCanFix);
+    // core.quotePath=false：非 ASCII 路径原样输出；--relative：路径相对项目目录，即使 .git 在更上层
+    const FString Base = DiffBase.IsEmpty() ? FString(TEXT("HEAD")) : DiffBase;
+    if (!RunGit(FString::Printf(TEXT("-c core.quotePath=false diff --name-only --relative --diff-filter=d %s"), *Base)))
+    {
+        return false;
     }
+    // 未跟踪文件缺失时结果不完整，不能当作完整的变更列表
+    return RunGit(TEXT("-c core.quotePath=false ls-files --others --exclude-standard"));
+}
+
+bool FAssetBatchValidatorModule::ValidateChangedFiles(
+    const TArray<FString>& ChangedFiles,
+    const FABVRuleSettings& Rules,
+    TArray<FABVTextureIssue>& OutIssues,
+    const FABVScanLimits& Limits)
+{
+    OutIssues.Reset();
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    TArray<FName> PackageNames;
+    ConvertFilesToPackageNames(ChangedFiles, PackageNames);
+
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+    TArray<FAssetData> Assets;
+    FindTexturesInPackages(PackageNames, [&AssetRegistry](FName PkgName, TArray<FAssetData>& OutPackageAssets)
+    {
+        AssetRegistry.GetAssetsByPackageName(PkgName, OutPackageAssets, /*bIncludeOnlyOnDiskAssets=*/true);
+    }, Assets);
+
+    const bool bComplete = ValidateAssets(Assets, Rules, OutIssues, Limits);
 
+    UE_LOG(LogTemp, Display, TEXT("=== ABV: Validate Changed Files: %d files -> %d packages -> %d textures in %.1f ms ==="),
+        ChangedFiles.Num(), PackageNames.Num(), Assets.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+    return bComplete;
+}
+
+void FAssetBatchValidatorModule::FindTexturesInPackages(
+    const TArray<FName>& PackageNames,
+    TFunctionRef<void(FName, TArray<FAssetData>&)> GetAssetsByPackage,
+    TArray<FAssetData>& OutAssets)
+{
+    const FTopLevelAssetPath TextureClass = UTexture2D::StaticClass()->GetClassPathName();
+
+    // 逐包查询，不遍历目录：耗时只和改动数量有关
+    TArray<FAssetData> PackageAssets;
+    for (const FName& PkgName : PackageNames)
+    {
+        PackageAssets.Reset();
+        GetAssetsByPackage(PkgName, PackageAssets);
+
+        for (const FAssetData& AD : PackageAssets)
+        {
+            if (AD.AssetClassPath == TextureClass)
+            {
+                OutAssets.Add(AD);
+            }
+        }
+    }
 }
 
 int32 FAssetBatchValidatorModule::FixTextures(const TArray<FABVTextureIssue>& IssuesToFix, int32 MaxTextureSize)
 {
+    TArray<FString> ChangedPaths;
+    return FixTextures(IssuesToFix, MaxTextureSize, ChangedPaths);
+}
+
+int32 FAssetBatchValidatorModule::FixTextures(const TArray<FABVTextureIssue>& IssuesToFix, int32 MaxTextureSize, TArray<FString>& OutChangedPaths)
+{
+    OutChangedPaths.Reset();
     if (IssuesToFix.Num() == 0) return 0;
 
     const FScopedTransaction Tx(NSLOCTEXT("AssetBatchValidator", "FixTextures", "ABV Fix Textures"));
@@ -307,6 +610,7 @@ int32 FAssetBatchValidatorModule::FixTextures(const TArray<FABVTextureIssue>& Is
         {
             Tex->PostEditChange();   // update assets status
             Tex->MarkPackageDirty(); // remind to save
+            OutChangedPaths.Add(Issue.AssetPath);
             FixedCount++;
         }
     }
@@ -314,6 +618,423 @@ int32 FAssetBatchValidatorModule::FixTextures(const TArray<FABVTextureIssue>& Is
     return FixedCount;
 }
 
+EABVTextureKind FAssetBatchValidatorModule::GuessKindFromName(const FString& ObjectPath)
+{
+    return ABV_GuessKindFromName(ObjectPath);
+}
+
+void FAssetBatchValidatorModule::FindDuplicateTextures(
+    const FName& RootPath,
+    bool bRecursive,
+    int32 NearThreshold,
+    TArray<FABVDuplicateGroup>& OutGroups)
+{
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+    FARFilter Filter;
+    Filter.PackagePaths.Add(RootPath);
+    Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
+    Filter.bRecursivePaths = bRecursive;
+
+    TArray<FAssetData> Assets;
+    AssetRegistry.GetAssets(Filter, Assets);
+
+    ABV_LLM_SCOPE();
+    FABVScopedMemoryPhase MemoryPhase(TEXT("Duplicates"));
+
+    // 哈希缓存：package 没变的贴图不再解码
+    FABVTextureHashIndex Index;
+    const FString CachePath = FABVTextureHashIndex::GetDefaultCachePath();
+    Index.LoadCache(CachePath);
+    Index.Update(Assets);
+    Index.SaveCache(CachePath);
+
+    Index.FindGroups(NearThreshold, OutGroups);
+
+    int64 TotalSavings = 0;
+    for (const FABVDuplicateGroup& G : OutGroups)
+    {
+        TotalSavings += G.EstimatedSavingsBytes;
+    }
+    UE_LOG(LogTemp, Display, TEXT("=== ABV: %d duplicate groups in %s, est. %.1f MB reclaimable ==="),
+        OutGroups.Num(), *RootPath.ToString(), TotalSavings / (1024.0 * 1024.0));
+}
+
+void FAssetBatchValidatorModule::DuplicateGroupsToIssues(const TArray<FABVDuplicateGroup>& Groups, TArray<FABVTextureIssue>& OutIssues)
+{
+    OutIssues.Reset();
+    for (const FABVDuplicateGroup& G : Groups)
+    {
+        const FString Keeper = FPackageName::GetShortName(G.AssetPaths[0]);
+        const FString Msg = FString::Printf(TEXT("%s duplicate of %s (group saves ~%.1f MB)"),
+            G.bExact ? TEXT("Exact") : TEXT("Near"), *Keeper, G.EstimatedSavingsBytes / (1024.0 * 1024.0));
+
+        for (int32 i = 1; i < G.AssetPaths.Num(); ++i)
+        {
+            ABV_AddIssue(OutIssues, G.AssetPaths[i], 0, 0, ABV_GuessKindFromName(G.AssetPaths[i]),
+                EABVIssueSeverity::Warning, Msg, /*bCanFix=*/false);
+        }
+    }
+}
+
+int32 FAssetBatchValidatorModule::ConsolidateDuplicates(const TArray<FABVDuplicateGroup>& Groups, bool bIncludeNearDuplicates)
+{
+    int32 NumConsolidated = 0;
+
+    for (const FABVDuplicateGroup& G : Groups)
+    {
+        if (!G.bExact && !bIncludeNearDuplicates) continue;
+        if (G.AssetPaths.Num() < 2) continue;
+
+        // 分组可能是之前 Find 的结果：合并前重新计算 source 哈希，和找到时不一致的贴图不动
+        auto LoadUnchanged = [&G](int32 i) -> UTexture2D*
+        {
+            UTexture2D* Tex = LoadObject<UTexture2D>(nullptr, *G.AssetPaths[i]);
+            FABVTextureFingerprint Fp;
+            if (!ABV_FingerprintTextureSource(Tex, Fp) || !G.ContentHashes.IsValidIndex(i) || Fp.ContentHash != G.ContentHashes[i])
+            {
+                UE_LOG(LogTemp, Warning, TEXT("ABV: %s changed since duplicates were found, not consolidated"), *G.AssetPaths[i]);
+                return nullptr;
+            }
+            return Tex;
+        };
+
+        UTexture2D* Keeper = LoadUnchanged(0);
+        if (!Keeper) continue;
+
+        TArray<UObject*> ToConsolidate;
+        for (int32 i = 1; i < G.AssetPaths.Num(); ++i)
+        {
+            if (UTexture2D* Dup = LoadUnchanged(i))
+            {
+                ToConsolidate.Add(Dup);
+            }
+        }
+        if (ToConsolidate.Num() == 0) continue;
+
+        // 引用重定向到 Keeper，删除重复资源前让用户确认（留下 redirector）
+        const ObjectTools::FConsolidationResults Results =
+            ObjectTools::ConsolidateObjects(Keeper, ToConsolidate, /*bShowDeleteConfirmation=*/true);
+        NumConsolidated += ToConsolidate.Num() - Results.FailedConsolidationObjs.Num();
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("ABV: Consolidated %d duplicate textures."), NumConsolidated);
+    return NumConsolidated;
+}
+
+void FAssetBatchValidatorModule::FindPackingCandidates(
+    const FName& RootPath,
+    bool bRecursive,
+    TArray<FABVPackingCandidate>& OutCandidates)
+{
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+    FARFilter Filter;
+    Filter.PackagePaths.Add(RootPath);
+    Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
+    Filter.bRecursivePaths = bRecursive;
+
+    TArray<FAssetData> Assets;
+    AssetRegistry.GetAssets(Filter, Assets);
+
+    ABV_FindPackingCandidates(Assets, OutCandidates);
+
+    int64 TotalSavings = 0;
+    int32 TotalSamplers = 0;
+    for (const FABVPackingCandidate& C : OutCandidates)
+    {
+        TotalSavings += C.EstimatedSavingsBytes;
+        TotalSamplers += C.NumSamplersSaved;
+    }
+    UE_LOG(LogTemp, Display, TEXT("=== ABV: %d channel packing candidates in %s, %d samplers and est. %.1f MB saved ==="),
+        OutCandidates.Num(), *RootPath.ToString(), TotalSamplers, TotalSavings / (1024.0 * 1024.0));
+}
+
+void FAssetBatchValidatorModule::PackingCandidatesToIssues(const TArray<FABVPackingCandidate>& Candidates, TArray<FABVTextureIssue>& OutIssues)
+{
+    static const TCHAR* SlotNames[] = { TEXT("AO"), TEXT("Roughness"), TEXT("Metallic"), TEXT("Opacity") };
+
+    OutIssues.Reset();
+    for (const FABVPackingCandidate& C : Candidates)
+    {
+        FString Slots;
+        FString FirstPath;
+        for (int32 i = 0; i < UE_ARRAY_COUNT(C.ChannelPaths); ++i)
+        {
+            if (C.ChannelPaths[i].IsEmpty()) continue;
+            if (!Slots.IsEmpty()) Slots += TEXT("+");
+            Slots += SlotNames[i];
+            if (FirstPath.IsEmpty()) FirstPath = C.ChannelPaths[i];
+        }
+
+        const FString Msg = FString::Printf(TEXT("Pack %s into %s_ORM: %d fewer samplers, ~%.1f MB"),
+            *Slots, *C.Stem, C.NumSamplersSaved, C.EstimatedSavingsBytes / (1024.0 * 1024.0));
+        ABV_AddIssue(OutIssues, FirstPath, C.Width, C.Height, EABVTextureKind::Mask,
+            EABVIssueSeverity::Warning, Msg, /*bCanFix=*/false);
+    }
+}
+
+static bool ABV_IsSingleChannelFormat(ERawImageFormat::Type Format)
+{
+    return Format == ERawImageFormat::G8 || Format == ERawImageFormat::G16
+        || Format == ERawImageFormat::R16F || Format == ERawImageFormat::R32F;
+}
+
+int32 FAssetBatchValidatorModule::PackChannels(const TArray<FABVPackingCandidate>& Candidates, TArray<FString>& OutCreatedPaths)
+{
+    OutCreatedPaths.Reset();
+    if (Candidates.Num() == 0) return 0;
+
+    const FScopedTransaction Tx(NSLOCTEXT("AssetBatchValidator", "PackChannels", "ABV Pack Channels"));
+
+    ABV_LLM_SCOPE();
+    FABVScopedMemoryPhase MemoryPhase(TEXT("Pack"));
+
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+    // 缺失通道的默认值：AO 1, Roughness 1, Metallic 0, Opacity 1
+    static const uint8 Fill[4] = { 255, 255, 0, 255 };
+
+    for (const FABVPackingCandidate& C : Candidates)
+    {
+        const FString PackedPath = C.GetPackedObjectPath();
+        if (AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(PackedPath)).IsValid())
+        {
+            continue;
+        }
+
+        FImage Planes[4];
+        const uint8* PlanePtrs[4] = {};
+        bool bOk = true;
+        for (int32 i = 0; i < 4 && bOk; ++i)
+        {
+            if (C.ChannelPaths[i].IsEmpty()) continue;
+
+            UTexture2D* Tex = LoadObject<UTexture2D>(nullptr, *C.ChannelPaths[i]);
+            FImage Src;
+            bOk = Tex && Tex->Source.IsValid() && Tex->Source.GetMipImage(Src, 0, 0, 0)
+                && Src.SizeX == C.Width && Src.SizeY == C.Height;
+            if (!bOk)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("ABV: Cannot pack %s, source %s missing or resized"), *C.Stem, *C.ChannelPaths[i]);
+                break;
+            }
+
+            // 多通道 source 转 G8 会把颜色混成亮度，宁可不打包
+            bOk = ABV_IsSingleChannelFormat(Src.Format);
+            if (!bOk)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("ABV: Cannot pack %s, source %s is %s, not single-channel"),
+                    *C.Stem, *C.ChannelPaths[i], ERawImageFormat::GetName(Src.Format));
+                break;
+            }
+
+            // 按存储的字节打包，不做 gamma 转换
+            Src.GammaSpace = EGammaSpace::Linear;
+            Src.CopyTo(Planes[i], ERawImageFormat::G8, EGammaSpace::Linear);
+            PlanePtrs[i] = Planes[i].RawData.GetData();
+        }
+        if (!bOk) continue;
+
+        FImage Packed(C.Width, C.Height, ERawImageFormat::BGRA8, EGammaSpace::Linear);
+        uint8* Out = Packed.RawData.GetData();
+
+        // 按行块并行交错
+        constexpr int32 RowsPerBlock = 64;
+        const int32 NumBlocks = FMath::DivideAndRoundUp(C.Height, RowsPerBlock);
+        ParallelFor(NumBlocks, [&](int32 Block)
+        {
+            const int64 Start = static_cast<int64>(Block) * RowsPerBlock * C.Width;
+            const int64 Count = static_cast<int64>(FMath::Min(RowsPerBlock, C.Height - Block * RowsPerBlock)) * C.Width;
+
+            const uint8* BlockPlanes[4];
+            for (int32 i = 0; i < 4; ++i)
+            {
+                BlockPlanes[i] = PlanePtrs[i] ? PlanePtrs[i] + Start : nullptr;
+            }
+            ABV_InterleaveChannels(BlockPlanes, Fill, Count, Out + Start * 4);
+        });
+
+        const FString PackageName = FPackageName::ObjectPathToPackageName(PackedPath);
+        UPackage* Package = CreatePackage(*PackageName);
+        UTexture2D* PackedTex = NewObject<UTexture2D>(Package, FName(*FPackageName::GetShortName(PackageName)),
+            RF_Public | RF_Standalone | RF_Transactional);
+
+        PackedTex->Source.Init(Packed);
+        PackedTex->SRGB = false;
+        PackedTex->CompressionSettings = TC_Masks;
+        PackedTex->PostEditChange();
+        PackedTex->MarkPackageDirty();
+        FAssetRegistryModule::AssetCreated(PackedTex);
+
+        OutCreatedPaths.Add(PackedPath);
+        UE_LOG(LogTemp, Display, TEXT("ABV: Packed %s (%dx%d), %d samplers saved"), *PackedPath, C.Width, C.Height, C.NumSamplersSaved);
+    }
+
+    return OutCreatedPaths.Num();
+}
+
+void FAssetBatchValidatorModule::ReloadPlatformProfiles()
+{
+    ABV_LoadPlatformProfiles(GEditorIni, PlatformProfiles);
+    UE_LOG(LogTemp, Display, TEXT("ABV: %d platform profiles loaded"), PlatformProfiles.Num());
+
+    int32 MemoryBudgetMB = 0;
+    GConfig->GetInt(TEXT("AssetBatchValidator"), TEXT("MemoryBudgetMB"), MemoryBudgetMB, GEditorIni);
+    FABVMemoryTracker::Get().SetBudgetBytes(static_cast<uint64>(FMath::Max(MemoryBudgetMB, 0)) * 1024 * 1024);
+}
+
+int32 FAssetBatchValidatorModule::ResizeTextureSources(
+    const TArray<FABVTextureIssue>& Issues,
+    int32 MaxTextureSize,
+    bool bMakePowerOfTwo,
+    TArray<FABVResizeResult>& OutResults)
+{
+    OutResults.Reset();
+    if (Issues.Num() == 0) return 0;
+
+    const FScopedTransaction Tx(NSLOCTEXT("AssetBatchValidator", "ResizeTextureSources", "ABV Resize Texture Sources"));
+
+    ABV_LLM_SCOPE();
+    FABVScopedMemoryPhase MemoryPhase(TEXT("Resize"));
+
+    struct FWork
+    {
+        UTexture2D* Tex = nullptr;
+        FImage Image;
+        int32 NewW = 0;
+        int32 NewH = 0;
+    };
+
+    auto ProcessBatch = [&OutResults](TArray<FWork>& Batch)
+    {
+        if (Batch.Num() == 0) return;
+
+        // 重采样与 UObject 无关，在后台跨贴图并行；贴图尺寸差异大，用工作窃取避免大图拖尾。
+        // 做完的贴图经通道交回游戏线程，其余贴图还在重采样时就提交 source，PostEditChange 的开销和重采样重叠
+        TABVResultChannel<int32> Finished;
+        UE::Tasks::FTask Resample = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Batch, &Finished]()
+        {
+            ABV_ParallelForAdaptive(Batch.Num(), [&Batch, &Finished](int32 Index)
+            {
+                FWork& W = Batch[Index];
+
+                FImage Linear;
+                W.Image.CopyTo(Linear, ERawImageFormat::RGBA32F, EGammaSpace::Linear);   // sRGB -> linear
+
+                FImage Resized(W.NewW, W.NewH, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+                ABV_ResampleLanczos3(
+                    reinterpret_cast<const FLinearColor*>(Linear.RawData.GetData()), Linear.SizeX, Linear.SizeY,
+                    reinterpret_cast<FLinearColor*>(Resized.RawData.GetData()), W.NewW, W.NewH);
+
+                FImage Out;
+                Resized.CopyTo(Out, W.Image.Format, W.Image.GammaSpace);   // 回到原格式 / 原 gamma
+                W.Image = MoveTemp(Out);
+
+                Finished.Push(Index);
+            });
+        });
+
+        // 结果按输入顺序占位，提交顺序随完成顺序
+        const int32 FirstResult = OutResults.Num();
+        OutResults.AddDefaulted(Batch.Num());
+
+        TArray<int32> Ready;
+        int32 NumCommitted = 0;
+        while (NumCommitted < Batch.Num())
+        {
+            Ready.Reset();
+            if (Finished.Drain(Ready) == 0)
+            {
+                FPlatformProcess::Sleep(0.0005f);
+                continue;
+            }
+
+            for (int32 Index : Ready)
+            {
+                FWork& W = Batch[Index];
+                FABVResizeResult& R = OutResults[FirstResult + Index];
+                R.AssetPath = W.Tex->GetPathName();
+                R.OldWidth = W.Tex->Source.GetSizeX();
+                R.OldHeight = W.Tex->Source.GetSizeY();
+                R.NewWidth = W.NewW;
+                R.NewHeight = W.NewH;
+                const int64 OldBytes = W.Tex->Source.CalcMipSize(0);
+
+                W.Tex->Modify(); // support Undo/Redo
+                W.Tex->Source.Init(W.Image);
+                W.Tex->PostEditChange();
+                W.Tex->MarkPackageDirty();
+
+                R.BytesSaved = OldBytes - W.Tex->Source.CalcMipSize(0);
+                UE_LOG(LogTemp, Display, TEXT("ABV: Resized %s %dx%d -> %dx%d, saved %lld bytes"),
+                    *R.AssetPath, R.OldWidth, R.OldHeight, R.NewWidth, R.NewHeight, R.BytesSaved);
+            }
+            NumCommitted += Ready.Num();
+        }
+        Resample.Wait();
+        Batch.Reset();
+    };
+
+    // 按像素预算分批，避免同时展开太多 RGBA32F 图
+    // 每像素同时存在 原图 + 线性副本 + 结果 约 3 x 16 bytes；配置了内存预算时按预算收紧
+    int64 BatchPixelBudget = 64ll * 1024 * 1024;
+    const uint64 MemoryBudget = FABVMemoryTracker::Get().GetBudgetBytes();
+    if (MemoryBudget > 0)
+    {
+        BatchPixelBudget = FMath::Clamp<int64>(static_cast<int64>(MemoryBudget / 48), 1024 * 1024, BatchPixelBudget);
+    }
+    int64 BatchPixels = 0;
+    TArray<FWork> Batch;
+
+    for (const FABVTextureIssue& Issue : Issues)
+    {
+        UTexture2D* Tex = LoadObject<UTexture2D>(nullptr, *Issue.AssetPath);
+        if (!Tex || !Tex->Source.IsValid()) continue;
+
+        // UDIM / 多层 source 不处理
+        if (Tex->Source.GetNumBlocks() != 1 || Tex->Source.GetNumLayers() != 1) continue;
+
+        int32 NewW = 0;
+        int32 NewH = 0;
+        if (!ABV_ComputeResizeTarget(Tex->Source.GetSizeX(), Tex->Source.GetSizeY(), MaxTextureSize, bMakePowerOfTwo, NewW, NewH))
+        {
+            continue;
+        }
+
+        FWork W;
+        W.Tex = Tex;
+        W.NewW = NewW;
+        W.NewH = NewH;
+        if (!Tex->Source.GetMipImage(W.Image, 0, 0, 0)) continue;
+
+        // 8-bit 颜色贴图在 sRGB 空间存储，需要在线性空间滤波
+        W.Image.GammaSpace = (Tex->SRGB && ERawImageFormat::GetFormatNeedsGammaSpace(W.Image.Format))
+            ? EGammaSpace::sRGB
+            : EGammaSpace::Linear;
+
+        BatchPixels += static_cast<int64>(W.Image.SizeX) * W.Image.SizeY;
+        Batch.Add(MoveTemp(W));
+
+        if (BatchPixels >= BatchPixelBudget)
+        {
+            ProcessBatch(Batch);
+            BatchPixels = 0;
+        }
+    }
+    ProcessBatch(Batch);
+
+    int64 TotalSaved = 0;
+    for (const FABVResizeResult& R : OutResults) TotalSaved += R.BytesSaved;
+    UE_LOG(LogTemp, Display, TEXT("ABV: Resized %d texture sources, saved %.1f MB"),
+        OutResults.Num(), TotalSaved / (1024.0 * 1024.0));
+
+    return OutResults.Num();
+}
+
 static FString ABV_KindToString(EABVTextureKind Kind)
 {
     switch (Kind)
@@ -358,12 +1079,29 @@ bool FAssetBatchValidatorModule::ExportReportCSV(const TArray<FABVTextureIssue>&
     }
 
     // 2) 拼 CSV 内容
+    // 平台列组：每个 profile 一组 Severity/Message，Severity 列是所有平台的最坏情况
+    TArray<FName> Platforms;
+    for (const FABVTextureIssue& I : Issues)
+    {
+        if (I.PlatformResults.Num() > 0)
+        {
+            for (const FABVPlatformResult& PR : I.PlatformResults) Platforms.Add(PR.Platform);
+            break;
+        }
+    }
+
     FString Csv;
-    Csv += TEXT("AssetPath,Width,Height,Kind,Severity,Message,CanFix\n");
+    Csv += TEXT("AssetPath,Width,Height,Kind,Severity,Message,CanFix");
+    for (const FName& Platform : Platforms)
+    {
+        Csv += FString::Printf(TEXT(",%s Severity,%s Message"),
+            *ABV_EscapeCSV(Platform.ToString()), *ABV_EscapeCSV(Platform.ToString()));
+    }
+    Csv += TEXT("\n");
 
     for (const FABVTextureIssue& I : Issues)
     {
-        Csv += FString::Printf(TEXT("%s,%d,%d,%s,%s,%s,%s\n"),
+        Csv += FString::Printf(TEXT("%s,%d,%d,%s,%s,%s,%s"),
             *ABV_EscapeCSV(I.AssetPath),
             I.Width,
             I.Height,
@@ -372,6 +1110,21 @@ bool FAssetBatchValidatorModule::ExportReportCSV(const TArray<FABVTextureIssue>&
             *ABV_EscapeCSV(I.Message),
             I.bCanFix ? TEXT("true") : TEXT("false")
         );
+
+        for (int32 p = 0; p < Platforms.Num(); ++p)
+        {
+            if (I.PlatformResults.IsValidIndex(p))
+            {
+                Csv += FString::Printf(TEXT(",%s,%s"),
+                    *ABV_EscapeCSV(ABV_SeverityToString(I.PlatformResults[p].Severity)),
+                    *ABV_EscapeCSV(I.PlatformResults[p].Message));
+            }
+            else
+            {
+                Csv += TEXT(",,");
+            }
+        }
+        Csv += TEXT("\n");
     }
 
     // 3) 写文件（失败只返回 false，不会 crash）
@@ -386,6 +1139,10 @@ bool FAssetBatchValidatorModule::ExportReportCSV(const TArray<FABVTextureIssue>&
 void FAssetBatchValidatorModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+    ReloadPlatformProfiles();
+    LoadSharedCacheSettings();
+    StartSourceWatcher();
+
     FGlobalTabmanager::Get()->RegisterNomadTabSpawner(
         ABV_TabName,
         FOnSpawnTab::CreateLambda([](const FSpawnTabArgs& Args)
@@ -434,6 +1191,18 @@ void FAssetBatchValidatorModule::ShutdownModule()
     {
         UToolMenus::UnregisterOwner(this);
     }
+
+    SharedCache.Reset();
+
+    if (FModuleManager::Get().IsModuleLoaded("AssetRegistry"))
+    {
+        FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get().OnFilesLoaded().Remove(FilesLoadedHandle);
+    }
+    if (SourceWatcher.IsValid())
+    {
+        SourceWatcher->Stop();
+        SourceWatcher.Reset();
+    }
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -21,6 +21,9 @@
 #include "Widgets/Input/SCheckBox.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Views/SListView.h"
+#include "Widgets/Views/STreeView.h"
+#include "Widgets/Views/SExpanderArrow.h"
+#include "Widgets/Layout/SWidgetSwitcher.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Layout/SScrollBox.h"
 #include "Widgets/Layout/SBorder.h"
@@ -33,6 +36,15 @@
 #include "Misc/Paths.h"
 #include "Framework/Notifications/NotificationManager.h"
 #include "Widgets/Notifications/SNotificationList.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "ABVResultsCache.h"
+#include "ABVSharedCache.h"
+#include "ABVStreamingScan.h"
+#include "ABVMemoryTracker.h"
+#include "ABVTextureRules.h"
+#include "Widgets/Layout/SSplitter.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "Editor.h"
 
 
 static FString KindToString(EABVTextureKind K)
@@ -105,36 +117,391 @@ static FSlateColor ABV_SeverityRowTint(EABVIssueSeverity Sev)
 }
 
 FReply SAssetBatchValidatorPanel::OnScanTexturesClicked()
+{
+    // 总是流式扫描：按影响排序，最严重的结果先出现在列表里；
+    // registry 还在扫描时也能边发现边验证，而不是拿到一份不完整的列表
+    StartStreamingScan();
+    return FReply::Handled();
+}
+
+void SAssetBatchValidatorPanel::StartStreamingScan()
+{
+    SetResultItems(TArray<FABVTextureIssue>());
+
+    FABVScanLimits Limits;
+    Limits.bImpactOrder = true;
+    StreamingScan = MakeShared<FABVStreamingScan>(TargetFolder, bRecursive, GetRuleSettings(), Limits);
+    StreamingScan->OnIssues.BindSP(this, &SAssetBatchValidatorPanel::AppendResultItems);
+    StreamingScan->OnComplete.BindLambda([this]()
+    {
+        SaveCachedResults();
+    });
+    StreamingScan->Start();
+}
+
+void SAssetBatchValidatorPanel::AppendResultItems(const TArray<FABVTextureIssue>& Issues)
+{
+    for (const FABVTextureIssue& It : Issues)
+    {
+        AddResultItem(It);
+    }
+
+    RefreshViews();
+}
+
+void SAssetBatchValidatorPanel::AddResultItem(const FABVTextureIssue& Issue)
+{
+    TSharedPtr<FABVTextureIssue> Item = MakeShared<FABVTextureIssue>(Issue);
+    TextureItems.Add(Item);
+    ItemsByPath.Add(Issue.AssetPath, Item);
+    Rollup.Add(Issue);
+}
+
+FReply SAssetBatchValidatorPanel::OnValidateChangedClicked()
 {
     FAssetBatchValidatorModule& Mod =
         FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
 
+    TArray<FString> ChangedFiles;
+    if (!Mod.GatherGitChangedFiles(TEXT("HEAD"), ChangedFiles))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ABV: Could not read git changes for %s"), *FPaths::ProjectDir());
+        return FReply::Handled();
+    }
+
     TArray<FABVTextureIssue> Issues;
+    Mod.ValidateChangedFiles(ChangedFiles, GetRuleSettings(), Issues);
 
-    Mod.ValidateTextures(
-        TargetFolder,
-        bRecursive,
-        MaxTextureSize,
-        bCheckPowerOfTwo,
-        bEnableNormalRules,
-        bEnableORMRules,
-        bCheckMipGen,
-        bCheckLODGroup,
-        Issues
-    );
+    SetResultItems(Issues);
+    return FReply::Handled();
+}
+
+SAssetBatchValidatorPanel::~SAssetBatchValidatorPanel()
+{
+    if (FAssetBatchValidatorModule* Mod = FModuleManager::GetModulePtr<FAssetBatchValidatorModule>("AssetBatchValidator"))
+    {
+        Mod->OnSourcesChanged().Remove(SourcesChangedHandle);
+    }
+    if (StreamingScan.IsValid())
+    {
+        StreamingScan->Cancel();
+    }
+    if (RevalidateTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(RevalidateTickerHandle);
+    }
+}
+
+void SAssetBatchValidatorPanel::HandleSourcesChanged(const TArray<FString>& AssetPaths, bool bReimported)
+{
+    int32 NumMarked = 0;
+    for (const FString& Path : AssetPaths)
+    {
+        const TSharedPtr<FABVTextureIssue>* Found = ItemsByPath.Find(Path);
+        if (!Found || !Found->IsValid()) continue;
+
+        const TSharedPtr<FABVTextureIssue>& Item = *Found;
+
+        // 源文件变了但还没重新导入：结果还是旧贴图的，只标记；重新导入后才值得重新验证
+        Item->bStale = true;
+        if (bReimported)
+        {
+            StaleItems.AddUnique(Item);
+        }
+        NumMarked++;
+    }
+    if (NumMarked == 0) return;
+
+    if (StaleItems.Num() > 0 && !RevalidateTickerHandle.IsValid())
+    {
+        RevalidateTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateSP(this, &SAssetBatchValidatorPanel::TickRevalidateStale));
+    }
+
+    if (TextureListView.IsValid())
+    {
+        TextureListView->RebuildList();
+    }
+}
+
+// 打开面板时只解码第一页（足够填满可见行），其余行在 tick 里按时间片解码
+static constexpr int32 ABV_CacheFirstPageRows = 256;
+
+void SAssetBatchValidatorPanel::LoadCachedResults()
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    TUniquePtr<FABVResultsCache> Cache = MakeUnique<FABVResultsCache>();
+    if (!Cache->Open(FABVResultsCache::GetDefaultPath()) || Cache->ReadRows(ABV_CacheFirstPageRows) == INDEX_NONE)
+    {
+        return;
+    }
+
+    if (!Cache->RootPath.IsNone())
+    {
+        TargetFolder = Cache->RootPath;
+    }
+    SetResultItems(Cache->Issues);
+    PendingCache = MoveTemp(Cache);
+
+    UE_LOG(LogTemp, Display, TEXT("ABV: Showing %d of %d cached results after %.1f ms"),
+        TextureItems.Num(), PendingCache->GetNumRows(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+    // 剩余行的解码、过期检查和重新验证放到 tick 里做，不阻塞面板打开
+    RevalidateTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateSP(this, &SAssetBatchValidatorPanel::TickRevalidateStale));
+}
+
+void SAssetBatchValidatorPanel::SaveCachedResults() const
+{
+    FABVResultsCache Cache;
+    Cache.RootPath = TargetFolder;
+    Cache.RulesFingerprint = FABVSharedCache::ComputeRulesFingerprint(GetRuleSettings());
+    Cache.Issues.Reserve(TextureItems.Num());
+    for (const TSharedPtr<FABVTextureIssue>& Item : TextureItems)
+    {
+        if (Item.IsValid()) Cache.Issues.Add(*Item);
+    }
+    Cache.CapturePackageHashes();
+
+    const FString Path = FABVResultsCache::GetDefaultPath();
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+    Cache.Save(Path);
+}
+
+bool SAssetBatchValidatorPanel::TickRevalidateStale(float DeltaTime)
+{
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+    // 每帧最多约 5ms
+    const double Deadline = FPlatformTime::Seconds() + 0.005;
+    bool bRowsChanged = false;
+
+    if (PendingCache.IsValid())
+    {
+        // 1) 从映射文件继续解码缓存行
+        while (!PendingCache->IsFullyRead() && FPlatformTime::Seconds() < Deadline)
+        {
+            const int32 Begin = PendingCache->Issues.Num();
+            if (PendingCache->ReadRows(ABV_CacheFirstPageRows) == INDEX_NONE)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("ABV: Results cache is corrupt, keeping the %d rows read so far"), TextureItems.Num());
+                PendingCache.Reset();
+                RevalidateTickerHandle.Reset();
+                return false;
+            }
+            for (int32 i = Begin; i < PendingCache->Issues.Num(); ++i)
+            {
+                AddResultItem(PendingCache->Issues[i]);
+            }
+            bRowsChanged = true;
+        }
+        if (!PendingCache->IsFullyRead())
+        {
+            RefreshViews();
+            return true;
+        }
+
+        // 2) 等 registry 扫描完成后再比较 package hash
+        if (AssetRegistry.IsLoadingAssets())
+        {
+            if (bRowsChanged)
+            {
+                RefreshViews();
+            }
+            return true;
+        }
+
+        PendingCache->MarkStale(FABVSharedCache::ComputeRulesFingerprint(GetRuleSettings()));
+        ensure(PendingCache->Issues.Num() == TextureItems.Num());
+        for (const FABVTextureIssue& Cached : PendingCache->Issues)
+        {
+            if (!Cached.bStale) continue;
+
+            // 按路径对应：列表在解码期间可能已被扫描或修复改过
+            const TSharedPtr<FABVTextureIssue>* Found = ItemsByPath.Find(Cached.AssetPath);
+            if (Found && Found->IsValid())
+            {
+                (*Found)->bStale = true;
+                StaleItems.AddUnique(*Found);
+                bRowsChanged = true;
+            }
+        }
+        PendingCache.Reset();
+
+        UE_LOG(LogTemp, Display, TEXT("ABV: %d cached results are stale, revalidating"), StaleItems.Num());
+    }
+
+    // 3) 分时间片重新验证
+    FAssetBatchValidatorModule& Mod =
+        FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
+    const FABVRuleSettings Rules = GetRuleSettings();
+    const FIoHash RulesFingerprint = Mod.GetSharedCache() ? FABVSharedCache::ComputeRulesFingerprint(Rules) : FIoHash::Zero;
+
+    bool bRemovedRows = false;
+    while (StaleItems.Num() > 0 && FPlatformTime::Seconds() < Deadline)
+    {
+        TSharedPtr<FABVTextureIssue> Item = StaleItems.Pop(EAllowShrinking::No);
+
+        const FAssetData AD = AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(Item->AssetPath));
+        FABVTextureIssue Fresh;
+        const bool bValid = AD.IsValid() && Mod.ValidateAsset(AD, Rules, RulesFingerprint, Fresh);
+        Rollup.Remove(*Item);
+        bRowsChanged = true;
+        if (!bValid)
+        {
+            // asset 已被删除
+            TextureItems.Remove(Item);
+            ItemsByPath.Remove(Item->AssetPath);
+            bRemovedRows = true;
+            continue;
+        }
+
+        const bool bWasSelected = Item->bSelected;
+        *Item = MoveTemp(Fresh);
+        Item->bSelected = bWasSelected;
+        Rollup.Add(*Item);
+
+        FABVMemoryTracker::Get().ReleaseScanLoads(FABVMemoryTracker::MaxScanLoads);
+    }
+
+    // 只有行内容变化时才重建可见行
+    if (bRowsChanged)
+    {
+        if (TextureListView.IsValid() && !bRemovedRows)
+        {
+            TextureListView->RebuildList();
+        }
+        RefreshViews();
+    }
+
+    if (StaleItems.Num() == 0)
+    {
+        FABVMemoryTracker::Get().ReleaseScanLoads();
+        SaveCachedResults();
+        RevalidateTickerHandle.Reset();
+        return false;
+    }
+    return true;
+}
+
+FABVRuleSettings SAssetBatchValidatorPanel::GetRuleSettings() const
+{
+    FABVRuleSettings Rules;
+    Rules.MaxTextureSize = MaxTextureSize;
+    Rules.bCheckPowerOfTwo = bCheckPowerOfTwo;
+    Rules.bEnableNormalRules = bEnableNormalRules;
+    Rules.bEnableORMRules = bEnableORMRules;
+    Rules.bCheckMipGen = bCheckMipGen;
+    Rules.bCheckLODGroup = bCheckLODGroup;
+
+    if (bUsePlatformProfiles)
+    {
+        const FAssetBatchValidatorModule& Mod =
+            FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
+        Rules.PlatformProfiles = Mod.GetPlatformProfiles();
+    }
+    return Rules;
+}
+
+void SAssetBatchValidatorPanel::SetResultItems(const TArray<FABVTextureIssue>& Issues)
+{
+    // 新结果替换缓存结果，停止后台重新验证 / 流式扫描
+    if (StreamingScan.IsValid())
+    {
+        StreamingScan->Cancel();
+        StreamingScan.Reset();
+    }
+    PendingCache.Reset();
+    StaleItems.Reset();
+    if (RevalidateTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(RevalidateTickerHandle);
+        RevalidateTickerHandle.Reset();
+    }
 
     TextureItems.Reset();
+    ItemsByPath.Reset();
+    Rollup.Reset();
     for (const FABVTextureIssue& It : Issues)
     {
-        TextureItems.Add(MakeShared<FABVTextureIssue>(It));
+        AddResultItem(It);
     }
 
+    RefreshViews();
+}
+
+void SAssetBatchValidatorPanel::RevalidateItems(const TArray<FString>& AssetPaths)
+{
+    if (AssetPaths.Num() == 0) return;
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    FAssetBatchValidatorModule& Mod =
+        FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
+
+    // 按路径直接找到改过的行，刷新耗时和修复数量成正比
+    TArray<FAssetData> Assets;
+    Assets.Reserve(AssetPaths.Num());
+    for (const FString& Path : AssetPaths)
+    {
+        if (!ItemsByPath.Contains(Path)) continue;
+
+        const FAssetData AD = AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(Path));
+        if (AD.IsValid())
+        {
+            Assets.Add(AD);
+        }
+    }
+
+    TArray<FABVTextureIssue> Fresh;
+    Mod.ValidateAssets(Assets, GetRuleSettings(), Fresh);
+
+    for (const FABVTextureIssue& Issue : Fresh)
+    {
+        const TSharedPtr<FABVTextureIssue>* Found = ItemsByPath.Find(Issue.AssetPath);
+        if (!Found || !Found->IsValid()) continue;
+
+        FABVTextureIssue& Item = **Found;
+        Rollup.Remove(Item);
+        const bool bWasSelected = Item.bSelected;
+        Item = Issue;
+        Item.bSelected = bWasSelected;
+        Rollup.Add(Item);
+    }
+
+    // 行控件里的文本是构建时写死的，重建可见行；RebuildList 不改变滚动位置
     if (TextureListView.IsValid())
     {
-        TextureListView->RequestListRefresh();
+        TextureListView->RebuildList();
     }
+    RefreshViews();
+    SaveCachedResults();
 
-    return FReply::Handled();
+    if (!InspectedPath.IsEmpty())
+    {
+        InspectAsset(InspectedPath);
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("ABV: Revalidated %d changed textures in %.1f ms"),
+        Fresh.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void SAssetBatchValidatorPanel::RefreshViews()
+{
+    if (TextureListView.IsValid())
+    {
+        TextureListView->RequestListRefresh();
+    }
+    if (FolderTreeView.IsValid() && bShowFolderRollup)
+    {
+        // GetRoots() 重新排序根节点数组（TreeItemsSource 指向它）；计数变化需要重建可见行
+        Rollup.GetRoots();
+        FolderTreeView->RebuildList();
+    }
 }
 
 FReply SAssetBatchValidatorPanel::OnFixSelectedClicked()
@@ -160,10 +527,11 @@ FReply SAssetBatchValidatorPanel::OnFixSelectedClicked()
     FAssetBatchValidatorModule& Mod =
         FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
 
-    const int32 Fixed = Mod.FixTextures(ToFix, MaxTextureSize);
+    TArray<FString> ChangedPaths;
+    const int32 Fixed = Mod.FixTextures(ToFix, MaxTextureSize, ChangedPaths);
     UE_LOG(LogTemp, Display, TEXT("ABV: Fixed %d checked textures."), Fixed);
 
-    OnScanTexturesClicked();
+    RevalidateItems(ChangedPaths);
     return FReply::Handled();
 }
 
@@ -181,10 +549,166 @@ FReply SAssetBatchValidatorPanel::OnFixAllFailedClicked()
     FAssetBatchValidatorModule& Mod =
         FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
 
-    const int32 Fixed = Mod.FixTextures(ToFix, MaxTextureSize);
+    TArray<FString> ChangedPaths;
+    const int32 Fixed = Mod.FixTextures(ToFix, MaxTextureSize, ChangedPaths);
     UE_LOG(LogTemp, Display, TEXT("ABV: Fixed %d textures (All Failed)."), Fixed);
 
-    return OnScanTexturesClicked();
+    RevalidateItems(ChangedPaths);
+    return FReply::Handled();
+}
+
+FReply SAssetBatchValidatorPanel::OnFindDuplicatesClicked()
+{
+    FAssetBatchValidatorModule& Mod =
+        FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
+
+    Mod.FindDuplicateTextures(TargetFolder, bRecursive, NearDuplicateThreshold, DuplicateGroups);
+
+    TArray<FABVTextureIssue> Issues;
+    FAssetBatchValidatorModule::DuplicateGroupsToIssues(DuplicateGroups, Issues);
+    SetResultItems(Issues);
+
+    int64 TotalSavings = 0;
+    for (const FABVDuplicateGroup& G : DuplicateGroups)
+    {
+        TotalSavings += G.EstimatedSavingsBytes;
+    }
+
+    FNotificationInfo Info(FText::FromString(FString::Printf(
+        TEXT("ABV: %d duplicate groups, ~%.1f MB reclaimable"), DuplicateGroups.Num(), TotalSavings / (1024.0 * 1024.0))));
+    Info.bFireAndForget = true;
+    Info.ExpireDuration = 4.0f;
+    FSlateNotificationManager::Get().AddNotification(Info);
+
+    return FReply::Handled();
+}
+
+FReply SAssetBatchValidatorPanel::OnConsolidateDuplicatesClicked()
+{
+    if (DuplicateGroups.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ABV: No duplicate groups. Run Find Duplicates first."));
+        return FReply::Handled();
+    }
+
+    FAssetBatchValidatorModule& Mod =
+        FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
+
+    // 只合并完全相同的贴图；近似重复需要人工确认
+    Mod.ConsolidateDuplicates(DuplicateGroups, /*bIncludeNearDuplicates=*/false);
+    return OnFindDuplicatesClicked();
+}
+
+FReply SAssetBatchValidatorPanel::OnFindPackingCandidatesClicked()
+{
+    FAssetBatchValidatorModule& Mod =
+        FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
+
+    Mod.FindPackingCandidates(TargetFolder, bRecursive, PackingCandidates);
+
+    TArray<FABVTextureIssue> Issues;
+    FAssetBatchValidatorModule::PackingCandidatesToIssues(PackingCandidates, Issues);
+    SetResultItems(Issues);
+
+    int64 TotalSavings = 0;
+    int32 TotalSamplers = 0;
+    for (const FABVPackingCandidate& C : PackingCandidates)
+    {
+        TotalSavings += C.EstimatedSavingsBytes;
+        TotalSamplers += C.NumSamplersSaved;
+    }
+
+    FNotificationInfo Info(FText::FromString(FString::Printf(
+        TEXT("ABV: %d packing candidates, %d samplers / ~%.1f MB saved"), PackingCandidates.Num(), TotalSamplers, TotalSavings / (1024.0 * 1024.0))));
+    Info.bFireAndForget = true;
+    Info.ExpireDuration = 4.0f;
+    FSlateNotificationManager::Get().AddNotification(Info);
+
+    return FReply::Handled();
+}
+
+FReply SAssetBatchValidatorPanel::OnPackChannelsClicked()
+{
+    if (PackingCandidates.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ABV: No packing candidates. Run Find Packing Candidates first."));
+        return FReply::Handled();
+    }
+
+    // 有勾选的行只打包勾选的候选，否则全部
+    TSet<FString> Checked;
+    for (const TSharedPtr<FABVTextureIssue>& Item : TextureItems)
+    {
+        if (Item.IsValid() && Item->bSelected) Checked.Add(Item->AssetPath);
+    }
+
+    TArray<FABVPackingCandidate> ToPack;
+    for (const FABVPackingCandidate& C : PackingCandidates)
+    {
+        bool bChecked = Checked.Num() == 0;
+        for (const FString& Path : C.ChannelPaths)
+        {
+            bChecked |= !Path.IsEmpty() && Checked.Contains(Path);
+        }
+        if (bChecked) ToPack.Add(C);
+    }
+
+    FAssetBatchValidatorModule& Mod =
+        FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
+
+    TArray<FString> Created;
+    Mod.PackChannels(ToPack, Created);
+
+    FNotificationInfo Info(FText::FromString(FString::Printf(
+        TEXT("ABV: Created %d packed ORM textures. Rewire materials to use them."), Created.Num())));
+    Info.bFireAndForget = true;
+    Info.ExpireDuration = 4.0f;
+    Info.Image = FAppStyle::Get().GetBrush("NotificationList.SuccessImage");
+    FSlateNotificationManager::Get().AddNotification(Info);
+
+    return OnFindPackingCandidatesClicked();
+}
+
+FReply SAssetBatchValidatorPanel::OnResizeSourcesClicked()
+{
+    // 勾选的行；oversized / non-POT 不要求 bCanFix
+    TArray<FABVTextureIssue> ToResize;
+    for (const TSharedPtr<FABVTextureIssue>& Item : TextureItems)
+    {
+        if (!Item.IsValid()) continue;
+        if (!Item->bSelected) continue;
+        if (Item->Severity == EABVIssueSeverity::OK) continue;
+
+        ToResize.Add(*Item);
+    }
+
+    if (ToResize.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ABV: No checked rows to resize."));
+        return FReply::Handled();
+    }
+
+    FAssetBatchValidatorModule& Mod =
+        FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
+
+    TArray<FABVResizeResult> Results;
+    Mod.ResizeTextureSources(ToResize, MaxTextureSize, bCheckPowerOfTwo, Results);
+
+    int64 TotalSaved = 0;
+    for (const FABVResizeResult& R : Results) TotalSaved += R.BytesSaved;
+
+    FNotificationInfo Info(FText::FromString(FString::Printf(
+        TEXT("ABV: Resized %d textures, saved %.1f MB of source data"), Results.Num(), TotalSaved / (1024.0 * 1024.0))));
+    Info.bFireAndForget = true;
+    Info.ExpireDuration = 4.0f;
+    Info.Image = FAppStyle::Get().GetBrush("NotificationList.SuccessImage");
+    FSlateNotificationManager::Get().AddNotification(Info);
+
+    TArray<FString> ChangedPaths;
+    ChangedPaths.Reserve(Results.Num());
+    for (const FABVResizeResult& R : Results) ChangedPaths.Add(R.AssetPath);
+    RevalidateItems(ChangedPaths);
+    return FReply::Handled();
 }
 
 FReply SAssetBatchValidatorPanel::OnExportCSVClicked()
@@ -231,15 +755,51 @@ FReply SAssetBatchValidatorPanel::OnExportCSVClicked()
     return FReply::Handled();
 }
 
+// Multi-line description from registry tags (no load); empty if the asset is unknown
+static FString ABV_DescribeAssetFromTags(const FString& AssetPathString)
+{
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    const FAssetData AD = AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(AssetPathString));
+    if (!AD.IsValid())
+    {
+        return FString();
+    }
+
+    FABVTextureFacts Facts;
+    const bool bHasTags = ABV_GatherTextureFactsFromTags(AssetPathString,
+        [&AD](FName Tag, FString& OutValue) { return AD.GetTagValue(Tag, OutValue); }, Facts);
+    if (!bHasTags)
+    {
+        return FString::Printf(TEXT("%s\n(no texture tags in registry)"), *AssetPathString);
+    }
+
+    FString Text = FString::Printf(
+        TEXT("%s\nSource: %dx%d\nCompression: %s\nsRGB: %s\nLOD Group: %s\nMip Gen: %s"),
+        *AssetPathString, Facts.Width, Facts.Height,
+        *UEnum::GetValueAsString(Facts.CompressionSettings),
+        Facts.bSRGB ? TEXT("true") : TEXT("false"),
+        *UEnum::GetValueAsString(Facts.LODGroup),
+        *UEnum::GetValueAsString(Facts.MipGenSettings));
+
+    const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(AD.PackageName);
+    if (PackageData.IsSet() && PackageData->DiskSize >= 0)
+    {
+        Text += FString::Printf(TEXT("\nPackage on disk: %.2f MB"), PackageData->DiskSize / (1024.0 * 1024.0));
+    }
+    return Text;
+}
+
 TSharedRef<ITableRow> SAssetBatchValidatorPanel::OnGenerateRow(
     TSharedPtr<FABVTextureIssue> Item,
     const TSharedRef<STableViewBase>& OwnerTable)
 {
     const FString SizeText = FString::Printf(TEXT("%dx%d"), Item->Width, Item->Height);
 
-    return SNew(STableRow<TSharedPtr<FABVTextureIssue>>, OwnerTable)
+    TSharedPtr<SHorizontalBox> Box;
+    TSharedRef<ITableRow> Row = SNew(STableRow<TSharedPtr<FABVTextureIssue>>, OwnerTable)
     [
-        SNew(SHorizontalBox)
+        SAssignNew(Box, SHorizontalBox)
 
         // 0) Checkbox 列（最左边）
         + SHorizontalBox::Slot()
@@ -266,6 +826,7 @@ TSharedRef<ITableRow> SAssetBatchValidatorPanel::OnGenerateRow(
         + SHorizontalBox::Slot().FillWidth(0.40f).Padding(6,2)
         [
             SNew(STextBlock).Text(FText::FromString(FPackageName::GetShortName(Item->AssetPath)))
+            .ToolTipText_Lambda([Item]() { return FText::FromString(ABV_DescribeAssetFromTags(Item->AssetPath)); })
         ]
 
         // 2) Size
@@ -283,7 +844,7 @@ TSharedRef<ITableRow> SAssetBatchValidatorPanel::OnGenerateRow(
         // 4) Result
         + SHorizontalBox::Slot().FillWidth(0.06f).Padding(6,2)
         [
-            SNew(STextBlock).Text(FText::FromString(SeverityToString(Item->Severity)))
+            SNew(STextBlock).Text(FText::FromString(SeverityToString(Item->Severity) + (Item->bStale ? TEXT(" (stale)") : TEXT(""))))
             .ColorAndOpacity(ABV_SeverityTextColor(Item->Severity))
         ]
 
@@ -295,7 +856,100 @@ TSharedRef<ITableRow> SAssetBatchValidatorPanel::OnGenerateRow(
             .ColorAndOpacity(ABV_SeverityTextColor(Item->Severity))
         ]
     ];
+
+    // 6) 每个平台一列
+    for (int32 p = 0; p < PlatformColumns.Num(); ++p)
+    {
+        const FABVPlatformResult* PR = Item->PlatformResults.IsValidIndex(p) ? &Item->PlatformResults[p] : nullptr;
+
+        Box->AddSlot().FillWidth(0.07f).Padding(6,2)
+        [
+            SNew(STextBlock)
+            .Text(FText::FromString(PR ? SeverityToString(PR->Severity) : TEXT("-")))
+            .ToolTipText(FText::FromString(PR ? PR->Message : FString()))
+            .ColorAndOpacity(ABV_SeverityTextColor(PR ? PR->Severity : EABVIssueSeverity::OK))
+        ];
+    }
+
+    return Row;
 }
+TSharedRef<ITableRow> SAssetBatchValidatorPanel::OnGenerateFolderRow(
+    TSharedPtr<FABVFolderNode> Node,
+    const TSharedRef<STableViewBase>& OwnerTable)
+{
+    const int32 NumErrors = Node->SeverityCounts[static_cast<int32>(EABVIssueSeverity::Error)];
+    const int32 NumWarnings = Node->SeverityCounts[static_cast<int32>(EABVIssueSeverity::Warning)];
+    const int32 NumOK = Node->SeverityCounts[static_cast<int32>(EABVIssueSeverity::OK)];
+
+    const FString KindText = FString::Printf(TEXT("Color %d / Normal %d / ORM %d / Mask %d"),
+        Node->KindCounts[static_cast<int32>(EABVTextureKind::Color)],
+        Node->KindCounts[static_cast<int32>(EABVTextureKind::Normal)],
+        Node->KindCounts[static_cast<int32>(EABVTextureKind::ORM)],
+        Node->KindCounts[static_cast<int32>(EABVTextureKind::Mask)]);
+
+    const EABVIssueSeverity WorstSev = NumErrors > 0 ? EABVIssueSeverity::Error
+        : (NumWarnings > 0 ? EABVIssueSeverity::Warning : EABVIssueSeverity::OK);
+
+    TSharedRef<STableRow<TSharedPtr<FABVFolderNode>>> Row =
+        SNew(STableRow<TSharedPtr<FABVFolderNode>>, OwnerTable);
+
+    Row->SetContent(
+        SNew(SHorizontalBox)
+
+        + SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center)
+        [
+            SNew(SExpanderArrow, Row)
+        ]
+
+        + SHorizontalBox::Slot().FillWidth(0.34f).Padding(6,2)
+        [
+            SNew(STextBlock).Text(FText::FromString(Node->Name))
+            .ToolTipText(FText::FromString(Node->FullPath))
+        ]
+
+        + SHorizontalBox::Slot().FillWidth(0.08f).Padding(6,2)
+        [
+            SNew(STextBlock).Text(FText::FromString(FString::Printf(TEXT("%d"), Node->NumAssets)))
+        ]
+
+        + SHorizontalBox::Slot().FillWidth(0.20f).Padding(6,2)
+        [
+            SNew(STextBlock).Text(FText::FromString(FString::Printf(TEXT("E %d  W %d  OK %d"), NumErrors, NumWarnings, NumOK)))
+            .ColorAndOpacity(ABV_SeverityTextColor(WorstSev))
+        ]
+
+        + SHorizontalBox::Slot().FillWidth(0.28f).Padding(6,2)
+        [
+            SNew(STextBlock).Text(FText::FromString(KindText))
+        ]
+
+        + SHorizontalBox::Slot().FillWidth(0.10f).Padding(6,2)
+        [
+            SNew(STextBlock).Text(FText::FromString(FString::Printf(TEXT("%.1f MB"), Node->EstimatedBytes / (1024.0 * 1024.0))))
+        ]
+    );
+
+    return Row;
+}
+
+void SAssetBatchValidatorPanel::OnGetFolderChildren(
+    TSharedPtr<FABVFolderNode> Node,
+    TArray<TSharedPtr<FABVFolderNode>>& OutChildren)
+{
+    if (Node.IsValid())
+    {
+        OutChildren = Node->GetSortedChildren();
+    }
+}
+
+void SAssetBatchValidatorPanel::OnFolderDoubleClicked(TSharedPtr<FABVFolderNode> Node)
+{
+    if (!Node.IsValid()) return;
+
+    // 双击文件夹 -> 作为下一次扫描的目标
+    TargetFolder = FName(*Node->FullPath);
+}
+
 void SAssetBatchValidatorPanel::OnRecursiveChanged(ECheckBoxState NewState)
 {
     bRecursive = (NewState == ECheckBoxState::Checked);
@@ -341,6 +995,15 @@ FReply SAssetBatchValidatorPanel::OnClearSelectionClicked()
 
 void SAssetBatchValidatorPanel::Construct(const FArguments& InArgs)
 {
+    const FAssetBatchValidatorModule& Mod =
+        FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
+    for (const FABVPlatformProfile& Profile : Mod.GetPlatformProfiles())
+    {
+        PlatformColumns.Add(Profile.Name);
+    }
+
+    TSharedPtr<SHeaderRow> HeaderRow;
+
     ChildSlot
     [
         SNew(SVerticalBox)
@@ -369,6 +1032,41 @@ void SAssetBatchValidatorPanel::Construct(const FArguments& InArgs)
             ]
         ]
         
+        + SVerticalBox::Slot().AutoHeight().Padding(8)
+        [
+            SNew(SCheckBox)
+                .IsChecked_Lambda([this]()
+                {
+                    return bUsePlatformProfiles ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+                })
+                .OnCheckStateChanged_Lambda([this](ECheckBoxState NewState)
+                {
+                    bUsePlatformProfiles = (NewState == ECheckBoxState::Checked);
+                })
+                .IsEnabled(PlatformColumns.Num() > 0)
+            [
+                SNew(STextBlock).Text(FText::FromString(FString::Printf(
+                    TEXT("Evaluate Platform Profiles (%d)"), PlatformColumns.Num())))
+            ]
+        ]
+        
+        + SVerticalBox::Slot().AutoHeight().Padding(8)
+        [
+            SNew(SCheckBox)
+                .IsChecked_Lambda([this]()
+                {
+                    return bShowFolderRollup ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+                })
+                .OnCheckStateChanged_Lambda([this](ECheckBoxState NewState)
+                {
+                    bShowFolderRollup = (NewState == ECheckBoxState::Checked);
+                    RefreshViews();
+                })
+            [
+                SNew(STextBlock).Text(FText::FromString(TEXT("Folder Rollup")))
+            ]
+        ]
+        
         + SVerticalBox::Slot().AutoHeight().Padding(8)
         [
             SNew(SButton)
@@ -382,6 +1080,14 @@ void SAssetBatchValidatorPanel::Construct(const FArguments& InArgs)
                 .Text(FText::FromString(TEXT("Scan Textures")))
                 .OnClicked(this, &SAssetBatchValidatorPanel::OnScanTexturesClicked)
         ]
+
+        + SVerticalBox::Slot().AutoHeight().Padding(8)
+        [
+            SNew(SButton)
+                .Text(FText::FromString(TEXT("Validate Changed Files (git)")))
+                .ToolTipText(FText::FromString(TEXT("Validate only the packages changed in the local git diff against HEAD.")))
+                .OnClicked(this, &SAssetBatchValidatorPanel::OnValidateChangedClicked)
+        ]
         
         + SVerticalBox::Slot().AutoHeight().Padding(8)
         [
@@ -401,6 +1107,14 @@ void SAssetBatchValidatorPanel::Construct(const FArguments& InArgs)
                 .OnClicked(this, &SAssetBatchValidatorPanel::OnFixAllFailedClicked)
             ]
             
+            + SHorizontalBox::Slot().AutoWidth().Padding(8,0,8,0)
+            [
+                SNew(SButton)
+                .Text(FText::FromString(TEXT("Resize Sources")))
+                .ToolTipText(FText::FromString(TEXT("Resample checked texture sources down to Max Texture Size / nearest power of two.")))
+                .OnClicked(this, &SAssetBatchValidatorPanel::OnResizeSourcesClicked)
+            ]
+            
             + SHorizontalBox::Slot().AutoWidth().Padding(0,0,8,0)
             [
                 SNew(SButton)
@@ -421,60 +1135,208 @@ void SAssetBatchValidatorPanel::Construct(const FArguments& InArgs)
                 .OnClicked(this, &SAssetBatchValidatorPanel::OnExportCSVClicked)
             ]
         ]
+
+        + SVerticalBox::Slot().AutoHeight().Padding(8)
+        [
+            SNew(SHorizontalBox)
+
+            + SHorizontalBox::Slot().AutoWidth().Padding(0,0,8,0)
+            [
+                SNew(SButton)
+                .Text(FText::FromString(TEXT("Find Duplicates")))
+                .ToolTipText(FText::FromString(TEXT("Group textures with identical or near-identical source data.")))
+                .OnClicked(this, &SAssetBatchValidatorPanel::OnFindDuplicatesClicked)
+            ]
+
+            + SHorizontalBox::Slot().AutoWidth()
+            [
+                SNew(SButton)
+                .Text(FText::FromString(TEXT("Consolidate Exact Duplicates")))
+                .OnClicked(this, &SAssetBatchValidatorPanel::OnConsolidateDuplicatesClicked)
+            ]
+
+            + SHorizontalBox::Slot().AutoWidth().Padding(8,0,8,0)
+            [
+                SNew(SButton)
+                .Text(FText::FromString(TEXT("Find Packing Candidates")))
+                .ToolTipText(FText::FromString(TEXT("Find sibling AO / roughness / metallic / opacity textures that could share one ORM texture.")))
+                .OnClicked(this, &SAssetBatchValidatorPanel::OnFindPackingCandidatesClicked)
+            ]
+
+            + SHorizontalBox::Slot().AutoWidth()
+            [
+                SNew(SButton)
+                .Text(FText::FromString(TEXT("Pack Channels")))
+                .ToolTipText(FText::FromString(TEXT("Create <Name>_ORM for the checked candidates (all if none checked).")))
+                .OnClicked(this, &SAssetBatchValidatorPanel::OnPackChannelsClicked)
+            ]
+        ]
         
 
         
-        // Result list
+        // Result list / folder rollup | inspector
         + SVerticalBox::Slot().FillHeight(1.0f).Padding(8)
         [
-            SAssignNew(TextureListView, SListView<TSharedPtr<FABVTextureIssue>>)
-                .ListItemsSource(&TextureItems)
-                .OnGenerateRow(this, &SAssetBatchValidatorPanel::OnGenerateRow)
-                .OnMouseButtonDoubleClick(this, &SAssetBatchValidatorPanel::OnItemDoubleClicked)
-                .HeaderRow(
-                    SNew(SHeaderRow)
-
-                    + SHeaderRow::Column("AssetPath")
-                    .DefaultLabel(FText::FromString("Asset"))
-                    .FillWidth(0.40f)
-
-                    + SHeaderRow::Column("Size")
-                    .DefaultLabel(FText::FromString("Size"))
-                    .FillWidth(0.08f)
-
-                    + SHeaderRow::Column("Kind")
-                    .DefaultLabel(FText::FromString("Type"))
-                    .FillWidth(0.06f)
-
-                    + SHeaderRow::Column("Severity")
-                    .DefaultLabel(FText::FromString("Result"))
-                    .FillWidth(0.06f)
-
-                    + SHeaderRow::Column("Message")
-                    .DefaultLabel(FText::FromString("Message"))
-                    .FillWidth(0.26f))
+            SNew(SSplitter)
+            .Orientation(Orient_Horizontal)
+
+            + SSplitter::Slot().Value(0.78f)
+            [
+                SNew(SWidgetSwitcher)
+                .WidgetIndex_Lambda([this]() { return bShowFolderRollup ? 1 : 0; })
+
+                + SWidgetSwitcher::Slot()
+                [
+                SAssignNew(TextureListView, SListView<TSharedPtr<FABVTextureIssue>>)
+                    .ListItemsSource(&TextureItems)
+                    .OnGenerateRow(this, &SAssetBatchValidatorPanel::OnGenerateRow)
+                    .OnMouseButtonDoubleClick(this, &SAssetBatchValidatorPanel::OnItemDoubleClicked)
+                    .OnSelectionChanged(this, &SAssetBatchValidatorPanel::OnItemSelectionChanged)
+                    .HeaderRow(
+                        SAssignNew(HeaderRow, SHeaderRow)
+
+                        + SHeaderRow::Column("AssetPath")
+                        .DefaultLabel(FText::FromString("Asset"))
+                        .FillWidth(0.40f)
+
+                        + SHeaderRow::Column("Size")
+                        .DefaultLabel(FText::FromString("Size"))
+                        .FillWidth(0.08f)
+
+                        + SHeaderRow::Column("Kind")
+                        .DefaultLabel(FText::FromString("Type"))
+                        .FillWidth(0.06f)
+
+                        + SHeaderRow::Column("Severity")
+                        .DefaultLabel(FText::FromString("Result"))
+                        .FillWidth(0.06f)
+
+                        + SHeaderRow::Column("Message")
+                        .DefaultLabel(FText::FromString("Message"))
+                        .FillWidth(0.26f))
+                ]
+
+                + SWidgetSwitcher::Slot()
+                [
+                    SAssignNew(FolderTreeView, STreeView<TSharedPtr<FABVFolderNode>>)
+                        .TreeItemsSource(&Rollup.GetRoots())
+                        .OnGenerateRow(this, &SAssetBatchValidatorPanel::OnGenerateFolderRow)
+                        .OnGetChildren(this, &SAssetBatchValidatorPanel::OnGetFolderChildren)
+                        .OnMouseButtonDoubleClick(this, &SAssetBatchValidatorPanel::OnFolderDoubleClicked)
+                        .HeaderRow(
+                            SNew(SHeaderRow)
+
+                            + SHeaderRow::Column("Folder")
+                            .DefaultLabel(FText::FromString("Folder"))
+                            .FillWidth(0.34f)
+
+                            + SHeaderRow::Column("Assets")
+                            .DefaultLabel(FText::FromString("Assets"))
+                            .FillWidth(0.08f)
+
+                            + SHeaderRow::Column("Severity")
+                            .DefaultLabel(FText::FromString("Errors / Warnings / OK"))
+                            .FillWidth(0.20f)
+
+                            + SHeaderRow::Column("Kinds")
+                            .DefaultLabel(FText::FromString("Types"))
+                            .FillWidth(0.28f)
+
+                            + SHeaderRow::Column("Memory")
+                            .DefaultLabel(FText::FromString("Est. Memory"))
+                            .FillWidth(0.10f))
+                ]
+            ]
+
+            // Inspector (registry tags only)
+            + SSplitter::Slot().Value(0.22f)
+            [
+                SNew(SVerticalBox)
+
+                + SVerticalBox::Slot().AutoHeight().Padding(6, 0, 0, 6)
+                [
+                    SNew(STextBlock)
+                    .Text_Lambda([this]() { return InspectorText; })
+                    .AutoWrapText(true)
+                ]
+
+                + SVerticalBox::Slot().AutoHeight().Padding(6, 0, 0, 0)
+                [
+                    SNew(SButton)
+                    .Text(FText::FromString(TEXT("Open Editor")))
+                    .ToolTipText(FText::FromString(TEXT("Load the texture and open it in the texture editor.")))
+                    .IsEnabled_Lambda([this]() { return !InspectedPath.IsEmpty(); })
+                    .OnClicked(this, &SAssetBatchValidatorPanel::OnOpenEditorClicked)
+                ]
+            ]
+        ]
+
+        // Validator memory per phase (peak / current above phase start)
+        + SVerticalBox::Slot().AutoHeight().Padding(8, 0, 8, 8)
+        [
+            SNew(STextBlock)
+            .Text_Lambda([]() { return FText::FromString(TEXT("Memory: ") + FABVMemoryTracker::Get().GetSummary()); })
         ]
     ];
-    
+
+    for (const FName& Platform : PlatformColumns)
+    {
+        HeaderRow->AddColumn(SHeaderRow::Column(Platform)
+            .DefaultLabel(FText::FromName(Platform))
+            .FillWidth(0.07f));
+    }
+
+    SourcesChangedHandle = FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator")
+        .OnSourcesChanged().AddSP(this, &SAssetBatchValidatorPanel::HandleSourcesChanged);
+
+    InspectAsset(FString());
+    LoadCachedResults();
 }
 void SAssetBatchValidatorPanel::SyncToContentBrowser(const FString& AssetPathString)
 {
-    // AssetPathString 形如 "/Game/xxx/T_A.T_A"
-    FSoftObjectPath SoftPath(AssetPathString);
-    UObject* Obj = SoftPath.TryLoad(); // 简单做法：保证拿到 UObject
+    // AssetPathString 形如 "/Game/xxx/T_A.T_A"；只用 registry 数据，不加载贴图
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    const FAssetData AD = AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(AssetPathString));
 
-    if (!Obj)
+    if (!AD.IsValid())
     {
-        UE_LOG(LogTemp, Warning, TEXT("ABV: Failed to load asset for sync: %s"), *AssetPathString);
+        UE_LOG(LogTemp, Warning, TEXT("ABV: Asset not found in registry for sync: %s"), *AssetPathString);
         return;
     }
 
-    TArray<UObject*> Objs;
-    Objs.Add(Obj);
+    TArray<FAssetData> Assets;
+    Assets.Add(AD);
 
     FContentBrowserModule& CB = FModuleManager::LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
-    CB.Get().SyncBrowserToAssets(Objs);
+    CB.Get().SyncBrowserToAssets(Assets);
+}
+
+void SAssetBatchValidatorPanel::InspectAsset(const FString& AssetPathString)
+{
+    InspectedPath = AssetPathString;
+    InspectorText = FText::FromString(AssetPathString.IsEmpty()
+        ? FString(TEXT("Select a row to inspect it."))
+        : ABV_DescribeAssetFromTags(AssetPathString));
 }
+
+void SAssetBatchValidatorPanel::OnItemSelectionChanged(TSharedPtr<FABVTextureIssue> Item, ESelectInfo::Type SelectInfo)
+{
+    InspectAsset(Item.IsValid() ? Item->AssetPath : FString());
+}
+
+FReply SAssetBatchValidatorPanel::OnOpenEditorClicked()
+{
+    if (InspectedPath.IsEmpty() || !GEditor)
+    {
+        return FReply::Handled();
+    }
+
+    // 唯一会加载贴图的交互：用户明确要编辑
+    GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->OpenEditorForAsset(FSoftObjectPath(InspectedPath));
+    return FReply::Handled();
+}
+
 void SAssetBatchValidatorPanel::OnItemDoubleClicked(TSharedPtr<FABVTextureIssue> Item)
 {
     if (!Item.IsValid()) return;
@@ -9,7 +9,12 @@
 #pragma once
 #include "Widgets/SBoxPanel.h"
 #include "ABVTypes.h"
+#include "ABVFolderRollup.h"
+#include "Containers/Ticker.h"
+struct FABVResultsCache;
+class FABVStreamingScan;
 template<typename ItemType> class SListView;
+template<typename ItemType> class STreeView;
 
 class SAssetBatchValidatorPanel : public SCompoundWidget
 {
@@ -18,16 +23,23 @@ public:
     SLATE_END_ARGS()
 
     void Construct(const FArguments& InArgs);
+    virtual ~SAssetBatchValidatorPanel();
 
 private:
     // UI actions
     FReply OnUseSelectedFolderClicked();
     FReply OnScanTexturesClicked();
+    FReply OnValidateChangedClicked();
     FReply OnFixSelectedClicked();
     FReply OnFixAllFailedClicked();
+    FReply OnResizeSourcesClicked();
     FReply OnSelectAllClicked();
     FReply OnClearSelectionClicked();
     FReply OnExportCSVClicked();
+    FReply OnFindDuplicatesClicked();
+    FReply OnConsolidateDuplicatesClicked();
+    FReply OnFindPackingCandidatesClicked();
+    FReply OnPackChannelsClicked();
     
 
     // Text / checkbox
@@ -37,6 +49,13 @@ private:
     ECheckBoxState GetRecursiveState() const;
     void OnItemDoubleClicked(TSharedPtr<FABVTextureIssue> Item);
     void SyncToContentBrowser(const FString& AssetPathString);
+
+    // Inspector: everything comes from asset registry tags; only "Open Editor" loads the texture
+    void OnItemSelectionChanged(TSharedPtr<FABVTextureIssue> Item, ESelectInfo::Type SelectInfo);
+    void InspectAsset(const FString& AssetPathString);
+    FReply OnOpenEditorClicked();
+    FString InspectedPath;
+    FText InspectorText;
     
 
 
@@ -51,10 +70,53 @@ private:
 
     bool bCheckMipGen = false;     
     bool bCheckLODGroup = false;
+
+    bool bUsePlatformProfiles = false;   // evaluate all module profiles in one pass
+
+    int32 NearDuplicateThreshold = 3;   // max Hamming distance of perceptual hashes
+    TArray<FABVDuplicateGroup> DuplicateGroups;
+    TArray<FABVPackingCandidate> PackingCandidates;
+
+    FABVRuleSettings GetRuleSettings() const;
+    void SetResultItems(const TArray<FABVTextureIssue>& Issues);
+    void AppendResultItems(const TArray<FABVTextureIssue>& Issues);
+    // Adds one row to TextureItems, ItemsByPath and the rollup
+    void AddResultItem(const FABVTextureIssue& Issue);
+    // Revalidates only the rows for these object paths, in place (selection and scroll position are kept)
+    void RevalidateItems(const TArray<FString>& AssetPaths);
+
+    // Results cache: last full scan is shown at construction, stale rows are revalidated on tick
+    void LoadCachedResults();
+    void SaveCachedResults() const;
+    bool TickRevalidateStale(float DeltaTime);
+
+    TUniquePtr<FABVResultsCache> PendingCache;   // kept until the registry can answer the stale check
+    TArray<TSharedPtr<FABVTextureIssue>> StaleItems;
+    FTSTicker::FDelegateHandle RevalidateTickerHandle;
+
+    // Import source files changed on disk: rows are marked stale, and revalidated if the textures were reimported
+    void HandleSourcesChanged(const TArray<FString>& AssetPaths, bool bReimported);
+    FDelegateHandle SourcesChangedHandle;
+
+    // Scan started while the asset registry is still discovering assets
+    void StartStreamingScan();
+    TSharedPtr<FABVStreamingScan> StreamingScan;
     
     // List data (ListView 用 SharedPtr)
     TSharedRef<ITableRow> OnGenerateRow(TSharedPtr<FABVTextureIssue> Item, const TSharedRef<STableViewBase>& OwnerTable);
 
     TArray<TSharedPtr<FABVTextureIssue>> TextureItems;
+    TMap<FString, TSharedPtr<FABVTextureIssue>> ItemsByPath;   // object path -> row, kept in sync with TextureItems
     TSharedPtr<SListView<TSharedPtr<FABVTextureIssue>>> TextureListView;
+    TArray<FName> PlatformColumns;   // one Result column per platform profile
+
+    // Folder rollup: kept in sync with TextureItems, tree rows are only built for expanded folders
+    TSharedRef<ITableRow> OnGenerateFolderRow(TSharedPtr<FABVFolderNode> Node, const TSharedRef<STableViewBase>& OwnerTable);
+    void OnGetFolderChildren(TSharedPtr<FABVFolderNode> Node, TArray<TSharedPtr<FABVFolderNode>>& OutChildren);
+    void OnFolderDoubleClicked(TSharedPtr<FABVFolderNode> Node);
+    void RefreshViews();
+
+    bool bShowFolderRollup = false;
+    FABVFolderRollup Rollup;
+    TSharedPtr<STreeView<TSharedPtr<FABVFolderNode>>> FolderTreeView;
 };
@@ -0,0 +1,169 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AssetBatchValidator.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/AssetRegistryState.h"
+#include "Engine/Texture2D.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// 变更列表查询的耗时应只和改动数量有关：同样 64 个改动包，分别在 1k / 10k / 100k 资源的 registry 里查
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FABVChangeListLatencyTest, "AssetBatchValidator.ChangeList.LatencyIndependentOfRegistrySize",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FABVChangeListLatencyTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumChanged = 64;
+    constexpr int32 NumReps = 20;
+    const int32 RegistrySizes[] = { 1000, 10000, 100000 };
+
+    const FTopLevelAssetPath TextureClass = UTexture2D::StaticClass()->GetClassPathName();
+    const FTopLevelAssetPath MeshClass(TEXT("/Script/Engine"), TEXT("StaticMesh"));
+
+    double BestMs[UE_ARRAY_COUNT(RegistrySizes)] = {};
+    for (int32 s = 0; s < UE_ARRAY_COUNT(RegistrySizes); ++s)
+    {
+        const int32 NumAssets = RegistrySizes[s];
+
+        // 一半贴图一半网格，包名分散在 100 个目录里
+        FAssetRegistryState State;
+        for (int32 i = 0; i < NumAssets; ++i)
+        {
+            const FString PackagePath = FString::Printf(TEXT("/Game/Bench/Dir%02d"), i % 100);
+            const FString AssetName = FString::Printf(TEXT("Asset_%06d"), i);
+            State.AddAssetData(new FAssetData(FName(PackagePath / AssetName), FName(PackagePath), FName(AssetName),
+                (i % 2 == 0) ? TextureClass : MeshClass));
+        }
+
+        TArray<FName> ChangedPackages;
+        for (int32 c = 0; c < NumChanged; ++c)
+        {
+            const int32 i = static_cast<int32>(static_cast<int64>(c) * NumAssets / NumChanged);
+            ChangedPackages.Add(FName(FString::Printf(TEXT("/Game/Bench/Dir%02d/Asset_%06d"), i % 100, i)));
+        }
+
+        auto Lookup = [&State](FName PkgName, TArray<FAssetData>& OutAssets)
+        {
+            for (const FAssetData* AD : State.GetAssetsByPackageName(PkgName))
+            {
+                OutAssets.Add(*AD);
+            }
+        };
+
+        double Best = DBL_MAX;
+        TArray<FAssetData> Found;
+        for (int32 Rep = 0; Rep < NumReps; ++Rep)
+        {
+            Found.Reset();
+            const double StartTime = FPlatformTime::Seconds();
+            FAssetBatchValidatorModule::FindTexturesInPackages(ChangedPackages, Lookup, Found);
+            Best = FMath::Min(Best, FPlatformTime::Seconds() - StartTime);
+        }
+        BestMs[s] = Best * 1000.0;
+
+        TestEqual(FString::Printf(TEXT("Textures found in %d-asset registry"), NumAssets), Found.Num(), NumChanged / 2);
+        AddInfo(FString::Printf(TEXT("%d changed packages in %d-asset registry: %.3f ms"), NumChanged, NumAssets, BestMs[s]));
+    }
+
+    // 100 倍大的 registry 最多慢 4 倍（再留 0.5 ms 给计时抖动）；全量遍历会慢约 100 倍
+    const double Smallest = BestMs[0];
+    const double Largest = BestMs[UE_ARRAY_COUNT(RegistrySizes) - 1];
+    TestTrue(FString::Printf(TEXT("Lookup latency flat across registry sizes (%.3f ms vs %.3f ms)"), Smallest, Largest),
+        Largest <= Smallest * 4.0 + 0.5);
+
+    return true;
+}
+
+// 完整入口（文件 -> 包 -> registry -> ValidateAssets）在真实 registry 上：耗时按改动数量线性增长，
+// 和项目大小有关的固定开销（遍历目录、全量查询）应当为零
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FABVChangeListLiveRegistryTest, "AssetBatchValidator.ChangeList.ValidateChangedFilesScalesWithChange",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FABVChangeListLiveRegistryTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumSmall = 8;
+    constexpr int32 NumLarge = 64;
+
+    FAssetBatchValidatorModule& Mod =
+        FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    AssetRegistry.WaitForCompletion();
+
+    // 引擎自带贴图，任何项目里都在磁盘上
+    FARFilter Filter;
+    Filter.PackagePaths.Add(TEXT("/Engine"));
+    Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
+    Filter.bRecursivePaths = true;
+    Filter.bIncludeOnlyOnDiskAssets = true;
+    TArray<FAssetData> Textures;
+    AssetRegistry.GetAssets(Filter, Textures);
+    Textures.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+
+    TArray<FString> Files;
+    TSet<FName> Packages;
+    for (const FAssetData& AD : Textures)
+    {
+        if (Files.Num() >= NumLarge) break;
+        if (Packages.Contains(AD.PackageName)) continue;
+
+        Packages.Add(AD.PackageName);
+        Files.Add(FPaths::ConvertRelativePathToFull(
+            FPackageName::LongPackageNameToFilename(AD.PackageName.ToString(), FPackageName::GetAssetPackageExtension())));
+    }
+    if (Files.Num() < NumLarge)
+    {
+        AddWarning(FString::Printf(TEXT("Only %d engine texture packages on disk, skipping"), Files.Num()));
+        return true;
+    }
+    const TArray<FString> SmallFiles(Files.GetData(), NumSmall);
+
+    FABVRuleSettings Rules;
+    Rules.PlatformProfiles = Mod.GetPlatformProfiles();
+    TArray<FABVTextureIssue> Issues;
+
+    // 测试期间持有这些贴图：扫描不会释放之前已加载的资源，计时只含查询 + 评估，不含加载和 GC
+    TArray<TStrongObjectPtr<UObject>> Held;
+    for (const FAssetData& AD : Textures)
+    {
+        if (Packages.Contains(AD.PackageName))
+        {
+            Held.Emplace(AD.GetAsset());
+        }
+    }
+    Mod.ValidateChangedFiles(Files, Rules, Issues);
+    TestTrue(TEXT("Every changed texture package is validated"), Issues.Num() >= NumLarge);
+
+    auto BestMs = [&Mod, &Rules, &Issues](const TArray<FString>& ChangedFiles)
+    {
+        double Best = DBL_MAX;
+        for (int32 Rep = 0; Rep < 5; ++Rep)
+        {
+            const double StartTime = FPlatformTime::Seconds();
+            Mod.ValidateChangedFiles(ChangedFiles, Rules, Issues);
+            Best = FMath::Min(Best, FPlatformTime::Seconds() - StartTime);
+        }
+        return Best * 1000.0;
+    };
+    const double SmallMs = BestMs(SmallFiles);
+    const double LargeMs = BestMs(Files);
+
+    // 两点拟合：斜率是每个文件的代价，截距是与改动数量无关的固定开销
+    const double PerFileMs = FMath::Max(0.0, (LargeMs - SmallMs) / (NumLarge - NumSmall));
+    const double FixedMs = SmallMs - PerFileMs * NumSmall;
+
+    AddInfo(FString::Printf(TEXT("Live registry (%d engine textures): %d files %.3f ms, %d files %.3f ms -> %.3f ms/file + %.3f ms fixed"),
+        Textures.Num(), NumSmall, SmallMs, NumLarge, LargeMs, PerFileMs, FixedMs));
+
+    // 固定开销只有模块/registry 查找，远小于一次全量枚举
+    TestTrue(FString::Printf(TEXT("Fixed cost independent of project size (%.3f ms)"), FixedMs), FixedMs <= 2.0);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,99 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ABVChannelPacking.h"
+#include "AssetRegistry/AssetData.h"
+#include "Engine/Texture2D.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// 参考实现：逐像素按 B = Metallic, G = Roughness, R = Occlusion, A = Opacity 写出
+static void ABV_InterleaveChannelsScalar(const uint8* const Planes[4], const uint8 Fill[4], int64 NumPixels, uint8* OutBGRA)
+{
+    const int32 Order[4] = {
+        static_cast<int32>(EABVPackChannel::Metallic),
+        static_cast<int32>(EABVPackChannel::Roughness),
+        static_cast<int32>(EABVPackChannel::Occlusion),
+        static_cast<int32>(EABVPackChannel::Opacity) };
+    for (int64 i = 0; i < NumPixels; ++i)
+    {
+        for (int32 c = 0; c < 4; ++c)
+        {
+            const int32 Slot = Order[c];
+            OutBGRA[i * 4 + c] = Planes[Slot] ? Planes[Slot][i] : Fill[Slot];
+        }
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FABVInterleaveTest, "AssetBatchValidator.ChannelPacking.InterleaveMatchesScalar",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FABVInterleaveTest::RunTest(const FString& Parameters)
+{
+    // 覆盖空输入、只有尾部、正好一个 16 像素块、块 + 尾部、多块
+    const int64 Lengths[] = { 0, 15, 16, 17, 1000 };
+    const uint8 Fill[4] = { 255, 128, 0, 255 };
+
+    for (int64 NumPixels : Lengths)
+    {
+        // 每个通道内容不同，顺序错了一定能看出来
+        TArray<uint8> Data[4];
+        for (int32 Slot = 0; Slot < 4; ++Slot)
+        {
+            Data[Slot].SetNumUninitialized(NumPixels);
+            for (int64 i = 0; i < NumPixels; ++i)
+            {
+                Data[Slot][i] = static_cast<uint8>(i * (Slot * 2 + 3) + Slot * 61);
+            }
+        }
+
+        // 16 种有无组合：缺的通道取 Fill
+        for (uint32 Mask = 0; Mask < 16; ++Mask)
+        {
+            const uint8* Planes[4];
+            for (int32 Slot = 0; Slot < 4; ++Slot)
+            {
+                Planes[Slot] = (Mask & (1u << Slot)) ? Data[Slot].GetData() : nullptr;
+            }
+
+            TArray<uint8> Expected;
+            TArray<uint8> Got;
+            Expected.SetNumZeroed(NumPixels * 4);
+            Got.SetNumZeroed(NumPixels * 4);
+            ABV_InterleaveChannelsScalar(Planes, Fill, NumPixels, Expected.GetData());
+            ABV_InterleaveChannels(Planes, Fill, NumPixels, Got.GetData());
+
+            if (Got != Expected)
+            {
+                int64 First = 0;
+                while (Got[First] == Expected[First]) ++First;
+                AddError(FString::Printf(TEXT("%lld pixels, planes mask %u: first difference at byte %lld (got %d, expected %d)"),
+                    NumPixels, Mask, First, Got[First], Expected[First]));
+            }
+        }
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FABVSingleChannelTagTest, "AssetBatchValidator.ChannelPacking.SingleChannelFromTags",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FABVSingleChannelTagTest::RunTest(const FString& Parameters)
+{
+    auto MakeAsset = [](const TCHAR* Tag, const TCHAR* Value)
+    {
+        FAssetDataTagMap Tags;
+        Tags.Add(FName(Tag), Value);
+        return FAssetData(TEXT("/Game/ABVTest/T_Rock_AO"), TEXT("/Game/ABVTest"), TEXT("T_Rock_AO"),
+            UTexture2D::StaticClass()->GetClassPathName(), MoveTemp(Tags));
+    };
+
+    TestTrue(TEXT("TC_Grayscale is single-channel"), ABV_IsSingleChannelTexture(MakeAsset(TEXT("CompressionSettings"), TEXT("TC_Grayscale"))));
+    TestTrue(TEXT("TC_Alpha is single-channel"), ABV_IsSingleChannelTexture(MakeAsset(TEXT("CompressionSettings"), TEXT("TC_Alpha"))));
+    TestFalse(TEXT("TC_Masks holds one mask per channel"), ABV_IsSingleChannelTexture(MakeAsset(TEXT("CompressionSettings"), TEXT("TC_Masks"))));
+    TestTrue(TEXT("G8 source is single-channel"), ABV_IsSingleChannelTexture(MakeAsset(TEXT("Format"), TEXT("TSF_G8"))));
+    TestFalse(TEXT("BGRA8 source is not"), ABV_IsSingleChannelTexture(MakeAsset(TEXT("Format"), TEXT("TSF_BGRA8"))));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AssetBatchValidator.h"
+#include "ABVMemoryTracker.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Texture2D.h"
+#include "Misc/AutomationTest.h"
+#include "Modules/ModuleManager.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// 扫描期间新加载的贴图最多持有一批，峰值不得超过这个包络
+static constexpr uint64 ABV_ScanEnvelopeBytes = 256ull * 1024 * 1024;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FABVScanMemoryEnvelopeTest, "AssetBatchValidator.Memory.ScanStaysWithinEnvelope",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FABVScanMemoryEnvelopeTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 MaxAssets = 2000;
+    constexpr int32 MinAssets = FABVMemoryTracker::MaxScanLoads * 2;
+
+    FAssetBatchValidatorModule& Mod =
+        FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    AssetRegistry.WaitForCompletion();
+    FABVMemoryTracker& Memory = FABVMemoryTracker::Get();
+
+    // 磁盘上、还没加载的引擎贴图：验证时走真实的 GetAsset() 加载
+    FARFilter Filter;
+    Filter.PackagePaths.Add(TEXT("/Engine"));
+    Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
+    Filter.bRecursivePaths = true;
+    Filter.bIncludeOnlyOnDiskAssets = true;
+    TArray<FAssetData> Candidates;
+    AssetRegistry.GetAssets(Filter, Candidates);
+
+    TArray<FAssetData> Assets;
+    for (const FAssetData& AD : Candidates)
+    {
+        if (Assets.Num() >= MaxAssets) break;
+        if (!AD.IsAssetLoaded())
+        {
+            Assets.Add(AD);
+        }
+    }
+    if (Assets.Num() < MinAssets)
+    {
+        AddWarning(FString::Printf(TEXT("Only %d unloaded engine textures on disk, need %d"), Assets.Num(), MinAssets));
+        return true;
+    }
+
+    // 新 phase 名：统计不受之前运行影响；同时按包络设预算，走一遍节流路径
+    const uint64 PrevBudget = Memory.GetBudgetBytes();
+    Memory.SetBudgetBytes(ABV_ScanEnvelopeBytes);
+
+    const FName Phase(TEXT("TestOnDiskScan"));
+    TArray<FABVTextureIssue> Issues;
+    {
+        FABVScopedMemoryPhase ScopedPhase(Phase);
+        Mod.ValidateAssets(Assets, FABVRuleSettings(), Issues);
+    }
+    Memory.SetBudgetBytes(PrevBudget);
+
+    TestEqual(TEXT("Every texture validated"), Issues.Num(), Assets.Num());
+    TestEqual(TEXT("No scan loads left tracked"), Memory.GetNumScanLoads(), 0);
+
+    // 只为验证而加载的贴图在扫描结束后都被回收
+    int32 NumStillLoaded = 0;
+    for (const FAssetData& AD : Assets)
+    {
+        NumStillLoaded += AD.IsAssetLoaded() ? 1 : 0;
+    }
+    TestEqual(TEXT("Textures loaded only for validation are released"), NumStillLoaded, 0);
+
+    const FABVMemoryPhaseStats* Stats = Memory.FindPhase(Phase);
+    if (!TestNotNull(TEXT("Phase recorded"), Stats))
+    {
+        return false;
+    }
+
+    AddInfo(FString::Printf(TEXT("%d on-disk textures: peak %.1f MB (%s), envelope %.0f MB, %d still loaded"),
+        Assets.Num(), Stats->PeakBytes / (1024.0 * 1024.0), FABVMemoryTracker::UsesLLMTag() ? TEXT("LLM tag") : TEXT("process"),
+        ABV_ScanEnvelopeBytes / (1024.0 * 1024.0), NumStillLoaded));
+    TestTrue(TEXT("On-disk scan stays within its memory envelope"), Stats->PeakBytes <= ABV_ScanEnvelopeBytes);
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
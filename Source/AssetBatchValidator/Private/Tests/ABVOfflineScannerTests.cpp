@@ -0,0 +1,58 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ABVOfflineScanner.h"
+#include "AssetBatchValidator.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// 离线扫描器只读 tag，编辑器路径加载贴图：同一批磁盘上的包，两边的每一行都必须一致
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FABVOfflineMatchesEditorTest, "AssetBatchValidator.Offline.MatchesEditorScan",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FABVOfflineMatchesEditorTest::RunTest(const FString& Parameters)
+{
+    // 引擎自带内容：每个安装都有，贴图数量小，tag 由引擎保存时写入
+    const FString PackageRoot = TEXT("/Engine/EngineResources");
+    const FString ContentDir = FPaths::EngineContentDir() / TEXT("EngineResources");
+    if (!FPaths::DirectoryExists(ContentDir))
+    {
+        AddWarning(FString::Printf(TEXT("%s not found, nothing to compare"), *ContentDir));
+        return true;
+    }
+
+    FABVRuleSettings Rules;
+
+    TArray<FABVTextureIssue> OfflineIssues;
+    TestTrue(TEXT("Offline scan completes"), FABVOfflineScanner::ScanDirectory(ContentDir, PackageRoot + TEXT("/"), Rules, OfflineIssues));
+
+    IAssetRegistry& AssetRegistry =
+        FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    AssetRegistry.ScanPathsSynchronous({ PackageRoot }, /*bForceRescan=*/false);
+
+    FAssetBatchValidatorModule& Mod =
+        FModuleManager::LoadModuleChecked<FAssetBatchValidatorModule>("AssetBatchValidator");
+    TArray<FABVTextureIssue> EditorIssues;
+    TestTrue(TEXT("Editor scan completes"), Mod.ValidateTextures(FName(*PackageRoot), /*bRecursive=*/true, Rules, EditorIssues));
+
+    if (!TestTrue(TEXT("Editor scan found textures to compare"), EditorIssues.Num() > 0))
+    {
+        return false;
+    }
+
+    TArray<FString> Mismatches;
+    FABVOfflineScanner::CompareWithEditor(EditorIssues, OfflineIssues, Mismatches);
+    for (const FString& Mismatch : Mismatches)
+    {
+        AddError(Mismatch);
+    }
+
+    AddInfo(FString::Printf(TEXT("%s: %d editor rows, %d offline rows, %d mismatches"),
+        *PackageRoot, EditorIssues.Num(), OfflineIssues.Num(), Mismatches.Num()));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,165 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ABVTextureResample.h"
+#include "ImageCore.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FABVResizeTargetTest, "AssetBatchValidator.Resample.TargetNeverLarger",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FABVResizeTargetTest::RunTest(const FString& Parameters)
+{
+    int32 OutW = 0;
+    int32 OutH = 0;
+
+    // 非 2 的幂向下取整，不放大
+    TestTrue(TEXT("800x600 needs a resize"), ABV_ComputeResizeTarget(800, 600, 0, true, OutW, OutH));
+    TestEqual(TEXT("800 -> 512"), OutW, 512);
+    TestEqual(TEXT("600 -> 512"), OutH, 512);
+
+    TestFalse(TEXT("1024x512 already fits"), ABV_ComputeResizeTarget(1024, 512, 2048, true, OutW, OutH));
+
+    ABV_ComputeResizeTarget(8192, 3000, 2048, true, OutW, OutH);
+    TestEqual(TEXT("8192 fits 2048"), OutW, 2048);
+    TestEqual(TEXT("3000 scaled then rounded down"), OutH, 512);
+
+    // 穷举：结果永远不大于输入，也不大于 MaxSize
+    const int32 MaxSizes[] = { 0, 256, 1000, 2048 };
+    for (int32 MaxSize : MaxSizes)
+    {
+        for (int32 W = 1; W <= 4100; W += 37)
+        {
+            for (int32 H = 1; H <= 4100; H += 53)
+            {
+                for (bool bPOT : { false, true })
+                {
+                    ABV_ComputeResizeTarget(W, H, MaxSize, bPOT, OutW, OutH);
+                    if (OutW > W || OutH > H || OutW < 1 || OutH < 1
+                        || (MaxSize > 0 && FMath::Max(OutW, OutH) > MaxSize)
+                        || (bPOT && (!FMath::IsPowerOfTwo(OutW) || !FMath::IsPowerOfTwo(OutH))))
+                    {
+                        AddError(FString::Printf(TEXT("%dx%d (max %d, POT %d) -> %dx%d"), W, H, MaxSize, bPOT ? 1 : 0, OutW, OutH));
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FABVLanczosFlatTest, "AssetBatchValidator.Resample.FlatColorStaysFlat",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FABVLanczosFlatTest::RunTest(const FString& Parameters)
+{
+    // 权重归一化：纯色缩小后每个像素仍是同一颜色（非整数倍缩放也一样）
+    constexpr int32 SrcW = 100;
+    constexpr int32 SrcH = 60;
+    constexpr int32 DstW = 37;
+    constexpr int32 DstH = 23;
+    const FLinearColor Color(0.3f, 0.6f, 0.1f, 0.8f);
+
+    TArray<FLinearColor> Src;
+    Src.Init(Color, SrcW * SrcH);
+    TArray<FLinearColor> Dst;
+    Dst.SetNumZeroed(DstW * DstH);
+    ABV_ResampleLanczos3(Src.GetData(), SrcW, SrcH, Dst.GetData(), DstW, DstH);
+
+    int32 NumOff = 0;
+    for (const FLinearColor& C : Dst)
+    {
+        NumOff += C.Equals(Color, 1e-4f) ? 0 : 1;
+    }
+    TestEqual(TEXT("Pixels that drifted from the flat color"), NumOff, 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FABVLanczosGradientTest, "AssetBatchValidator.Resample.GradientStaysMonotonic",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FABVLanczosGradientTest::RunTest(const FString& Parameters)
+{
+    // R 沿 x 递增、G 沿 y 递增，分别覆盖水平和垂直两趟；线性渐变没有边缘，不应出现振铃导致的回退
+    constexpr int32 SrcW = 256;
+    constexpr int32 SrcH = 96;
+    constexpr int32 DstW = 64;
+    constexpr int32 DstH = 37;
+
+    TArray<FLinearColor> Src;
+    Src.SetNumUninitialized(SrcW * SrcH);
+    for (int32 y = 0; y < SrcH; ++y)
+    {
+        for (int32 x = 0; x < SrcW; ++x)
+        {
+            Src[y * SrcW + x] = FLinearColor(static_cast<float>(x) / (SrcW - 1), static_cast<float>(y) / (SrcH - 1), 0.0f, 1.0f);
+        }
+    }
+    TArray<FLinearColor> Dst;
+    Dst.SetNumZeroed(DstW * DstH);
+    ABV_ResampleLanczos3(Src.GetData(), SrcW, SrcH, Dst.GetData(), DstW, DstH);
+
+    int32 NumBackwardX = 0;
+    int32 NumBackwardY = 0;
+    for (int32 y = 0; y < DstH; ++y)
+    {
+        for (int32 x = 0; x < DstW; ++x)
+        {
+            const FLinearColor& C = Dst[y * DstW + x];
+            NumBackwardX += (x > 0 && C.R <= Dst[y * DstW + x - 1].R) ? 1 : 0;
+            NumBackwardY += (y > 0 && C.G <= Dst[(y - 1) * DstW + x].G) ? 1 : 0;
+        }
+    }
+    TestEqual(TEXT("Horizontal ramp steps that are not increasing"), NumBackwardX, 0);
+    TestEqual(TEXT("Vertical ramp steps that are not increasing"), NumBackwardY, 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FABVLanczosSRGBTest, "AssetBatchValidator.Resample.SRGBKeepsLinearMean",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FABVLanczosSRGBTest::RunTest(const FString& Parameters)
+{
+    // 黑白棋盘格的线性均值是 0.5。走和 ResizeTextureSources 相同的路径（sRGB -> 线性 -> 重采样 -> sRGB），
+    // 缩小后应是线性 0.5 的灰（sRGB ~188）；在 gamma 空间里平均会得到 sRGB 128，也就是线性 ~0.22，明显偏暗
+    constexpr int32 SrcSize = 64;
+    constexpr int32 DstSize = 16;
+
+    FImage Source(SrcSize, SrcSize, ERawImageFormat::BGRA8, EGammaSpace::sRGB);
+    FColor* SrcPixels = reinterpret_cast<FColor*>(Source.RawData.GetData());
+    for (int32 y = 0; y < SrcSize; ++y)
+    {
+        for (int32 x = 0; x < SrcSize; ++x)
+        {
+            SrcPixels[y * SrcSize + x] = ((x + y) % 2) ? FColor::White : FColor::Black;
+        }
+    }
+
+    FImage Linear;
+    Source.CopyTo(Linear, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+
+    FImage Resized(DstSize, DstSize, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+    ABV_ResampleLanczos3(
+        reinterpret_cast<const FLinearColor*>(Linear.RawData.GetData()), Linear.SizeX, Linear.SizeY,
+        reinterpret_cast<FLinearColor*>(Resized.RawData.GetData()), DstSize, DstSize);
+
+    FImage Out;
+    Resized.CopyTo(Out, Source.Format, Source.GammaSpace);
+
+    const FColor* OutPixels = reinterpret_cast<const FColor*>(Out.RawData.GetData());
+    double Sum = 0.0;
+    for (int32 i = 0; i < DstSize * DstSize; ++i)
+    {
+        Sum += FLinearColor(OutPixels[i]).R;   // FColor -> FLinearColor 按 sRGB 解码
+    }
+    const double Mean = Sum / (DstSize * DstSize);
+
+    // 8 位量化在 0.5 附近约 0.004 一级
+    TestTrue(FString::Printf(TEXT("Linear mean after the sRGB round trip is 0.5 (got %.4f)"), Mean), FMath::Abs(Mean - 0.5) < 0.01);
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
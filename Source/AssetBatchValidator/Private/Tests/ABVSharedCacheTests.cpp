@@ -0,0 +1,114 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ABVSharedCache.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static FIoHash ABV_TestPackageHash(int32 Index)
+{
+    return FIoHash::HashBuffer(&Index, sizeof(Index));
+}
+
+static FABVTextureIssue ABV_TestIssue(int32 Index)
+{
+    FABVTextureIssue Issue;
+    Issue.AssetPath = FString::Printf(TEXT("/Game/ABVTest/T_%d.T_%d"), Index, Index);
+    Issue.Width = 512;
+    Issue.Height = 256;
+    Issue.Severity = (Index % 2) ? EABVIssueSeverity::Warning : EABVIssueSeverity::OK;
+    Issue.Message = FString::Printf(TEXT("test row %d"), Index);
+    return Issue;
+}
+
+static int64 ABV_TestDirectoryBytes(const FString& Directory)
+{
+    int64 TotalBytes = 0;
+    IFileManager::Get().IterateDirectoryStatRecursively(*Directory, [&TotalBytes](const TCHAR* Path, const FFileStatData& Stat)
+    {
+        if (!Stat.bIsDirectory && FStringView(Path).EndsWith(TEXT(".abv")))
+        {
+            TotalBytes += Stat.FileSize;
+        }
+        return true;
+    });
+    return TotalBytes;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FABVSharedCacheTest, "AssetBatchValidator.SharedCache.PutGetEvict",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FABVSharedCacheTest::RunTest(const FString& Parameters)
+{
+    const FString Directory = FPaths::AutomationTransientDir() / TEXT("ABVSharedCache") / FGuid::NewGuid().ToString();
+    ON_SCOPE_EXIT
+    {
+        IFileManager::Get().DeleteDirectory(*Directory, false, true);
+    };
+
+    constexpr int32 NumEntries = 20;
+    FABVRuleSettings Rules;
+    const FIoHash Fingerprint = FABVSharedCache::ComputeRulesFingerprint(Rules);
+
+    {
+        FABVSharedCache Cache(Directory, 0);
+        for (int32 i = 0; i < NumEntries; ++i)
+        {
+            Cache.Put(ABV_TestIssue(i).AssetPath, ABV_TestPackageHash(i), Fingerprint, ABV_TestIssue(i));
+        }
+        TestEqual(TEXT("Every put is written"), Cache.GetNumPuts(), NumEntries);
+
+        // 读回来和写进去的一样
+        const FABVTextureIssue Expected = ABV_TestIssue(3);
+        FABVTextureIssue Got;
+        if (TestTrue(TEXT("Get hits after Put"), Cache.Get(Expected.AssetPath, ABV_TestPackageHash(3), Fingerprint, Got)))
+        {
+            TestEqual(TEXT("Width round-trips"), Got.Width, Expected.Width);
+            TestEqual(TEXT("Height round-trips"), Got.Height, Expected.Height);
+            TestTrue(TEXT("Severity round-trips"), Got.Severity == Expected.Severity);
+            TestEqual(TEXT("Message round-trips"), Got.Message, Expected.Message);
+        }
+
+        // 规则变了、包变了，旧结果都不能命中
+        FABVRuleSettings OtherRules = Rules;
+        OtherRules.MaxTextureSize = Rules.MaxTextureSize * 2;
+        const FIoHash OtherFingerprint = FABVSharedCache::ComputeRulesFingerprint(OtherRules);
+        TestTrue(TEXT("Different rules give a different fingerprint"), OtherFingerprint != Fingerprint);
+        TestFalse(TEXT("Rules fingerprint mismatch is a miss"), Cache.Get(Expected.AssetPath, ABV_TestPackageHash(3), OtherFingerprint, Got));
+        TestFalse(TEXT("Package hash mismatch is a miss"), Cache.Get(Expected.AssetPath, ABV_TestPackageHash(4), Fingerprint, Got));
+    }
+
+    // 所有条目改成两天前写的，只有命中过的那个在淘汰前被刷新
+    const FDateTime Old = FDateTime::UtcNow() - FTimespan::FromDays(2.0);
+    IFileManager::Get().IterateDirectoryStatRecursively(*Directory, [&Old](const TCHAR* Path, const FFileStatData& Stat)
+    {
+        if (!Stat.bIsDirectory)
+        {
+            IFileManager::Get().SetTimeStamp(Path, Old);
+        }
+        return true;
+    });
+
+    const int64 FullBytes = ABV_TestDirectoryBytes(Directory);
+    const int64 MaxBytes = FullBytes / 2;
+    {
+        FABVSharedCache Cache(Directory, MaxBytes);
+        FABVTextureIssue Got;
+        TestTrue(TEXT("Hit before eviction"), Cache.Get(ABV_TestIssue(0).AssetPath, ABV_TestPackageHash(0), Fingerprint, Got));
+
+        Cache.Evict();
+
+        const int64 RemainingBytes = ABV_TestDirectoryBytes(Directory);
+        TestTrue(FString::Printf(TEXT("Directory under MaxBytes after eviction (%lld of %lld)"), RemainingBytes, MaxBytes), RemainingBytes <= MaxBytes);
+        TestTrue(TEXT("Eviction deleted something"), RemainingBytes < FullBytes);
+        TestTrue(TEXT("Recently hit entry survives eviction"), Cache.Get(ABV_TestIssue(0).AssetPath, ABV_TestPackageHash(0), Fingerprint, Got));
+    }
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
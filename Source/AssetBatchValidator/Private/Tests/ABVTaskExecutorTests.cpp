@@ -0,0 +1,198 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ABVTaskExecutor.h"
+#include "Algo/AllOf.h"
+#include "Async/ParallelFor.h"
+#include "Misc/AutomationTest.h"
+#include "Tasks/Task.h"
+
+#include <atomic>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static uint32 ABV_SpinWork(int32 Iterations, uint32 Seed)
+{
+    uint32 X = Seed | 1u;
+    for (int32 i = 0; i < Iterations; ++i)
+    {
+        X ^= X << 13;
+        X ^= X >> 17;
+        X ^= X << 5;
+    }
+    return X;
+}
+
+template<typename FRunner>
+static double ABV_BestOf3(FRunner&& Run)
+{
+    double Best = DBL_MAX;
+    for (int32 Rep = 0; Rep < 3; ++Rep)
+    {
+        const double StartTime = FPlatformTime::Seconds();
+        Run();
+        Best = FMath::Min(Best, FPlatformTime::Seconds() - StartTime);
+    }
+    return Best * 1000.0;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FABVExecutorCoverageTest, "AssetBatchValidator.Executor.VisitsEveryIndexOnce",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FABVExecutorCoverageTest::RunTest(const FString& Parameters)
+{
+    // 开头几个下标很贵，逼其他 worker 去偷
+    const int32 Sizes[] = { 0, 1, 7, 1000, 100000 };
+    for (int32 Num : Sizes)
+    {
+        TUniquePtr<std::atomic<int32>[]> Visits = MakeUnique<std::atomic<int32>[]>(Num);
+
+        FABVExecutorStats Stats;
+        ABV_ParallelForAdaptive(Num, [&Visits](int32 Index)
+        {
+            if (Index < 8)
+            {
+                ABV_SpinWork(200000, static_cast<uint32>(Index));
+            }
+            Visits[Index].fetch_add(1, std::memory_order_relaxed);
+        }, &Stats);
+
+        int32 NumWrong = 0;
+        for (int32 i = 0; i < Num; ++i)
+        {
+            NumWrong += (Visits[i].load() != 1) ? 1 : 0;
+        }
+        TestEqual(FString::Printf(TEXT("Indices not visited exactly once (Num=%d, %d workers, %d steals)"), Num, Stats.NumWorkers, Stats.NumSteals), NumWrong, 0);
+    }
+    return true;
+}
+
+// 多个生产者并发 Push，消费者在生产期间同时 Drain：每一项恰好收到一次，结束时没有残留
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FABVResultChannelTest, "AssetBatchValidator.Executor.ChannelDeliversEveryItemOnce",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FABVResultChannelTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumProducers = 8;
+    constexpr int32 ItemsPerProducer = 20000;
+    constexpr int32 NumItems = NumProducers * ItemsPerProducer;
+
+    TABVResultChannel<int32> Channel;
+    TArray<UE::Tasks::FTask> Producers;
+    for (int32 P = 0; P < NumProducers; ++P)
+    {
+        Producers.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Channel, P]()
+        {
+            for (int32 i = 0; i < ItemsPerProducer; ++i)
+            {
+                Channel.Push(P * ItemsPerProducer + i);
+            }
+        }));
+    }
+
+    TArray<int32> Received;
+    Received.Reserve(NumItems);
+    int32 NumDrainsWhileRunning = 0;
+    auto AllProduced = [&Producers]()
+    {
+        return Algo::AllOf(Producers, [](const UE::Tasks::FTask& Task) { return Task.IsCompleted(); });
+    };
+    while (!AllProduced())
+    {
+        NumDrainsWhileRunning += Channel.Drain(Received) > 0 ? 1 : 0;
+    }
+    Channel.Drain(Received);
+
+    TArray<int32> Counts;
+    Counts.SetNumZeroed(NumItems);
+    int32 NumOutOfRange = 0;
+    for (int32 Item : Received)
+    {
+        if (Item < 0 || Item >= NumItems)
+        {
+            ++NumOutOfRange;
+            continue;
+        }
+        ++Counts[Item];
+    }
+    int32 NumWrong = 0;
+    for (int32 Count : Counts)
+    {
+        NumWrong += (Count != 1) ? 1 : 0;
+    }
+
+    AddInfo(FString::Printf(TEXT("%d producers x %d items, %d non-empty drains while producing"), NumProducers, ItemsPerProducer, NumDrainsWhileRunning));
+    TestEqual(TEXT("Items received"), Received.Num(), NumItems);
+    TestEqual(TEXT("Items not received exactly once"), NumWrong, 0);
+    TestEqual(TEXT("Items that were never pushed"), NumOutOfRange, 0);
+    TestEqual(TEXT("Nothing left pending"), Channel.GetNumPending(), 0);
+    return true;
+}
+
+// 重项集中在末尾（按大小排序后的常见情况）：ParallelFor 最后几批全是重项，尾部拖慢；自适应批大小 + 窃取应当更快
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FABVExecutorSkewTest, "AssetBatchValidator.Executor.ClusteredWorkloadFasterThanParallelFor",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FABVExecutorSkewTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumItems = 20000;
+    constexpr int32 HeavyEvery = 50;
+
+    // 轻量项模拟只看 tag 的检查，重项约 400 倍，模拟 8K 贴图分析
+    constexpr int32 LightIterations = 200;
+    constexpr int32 HeavyIterations = LightIterations * 400;
+    constexpr int32 NumHeavy = NumItems / HeavyEvery;
+
+    TArray<int32> Clustered;
+    TArray<int32> Scattered;
+    Clustered.SetNum(NumItems);
+    Scattered.SetNum(NumItems);
+    for (int32 i = 0; i < NumItems; ++i)
+    {
+        Clustered[i] = (i >= NumItems - NumHeavy) ? HeavyIterations : LightIterations;
+        Scattered[i] = (i % HeavyEvery == 0) ? HeavyIterations : LightIterations;
+    }
+
+    std::atomic<uint32> Sink{ 0 };
+    auto Measure = [this, &Sink](const TCHAR* Name, const TArray<int32>& Costs, double& OutPlainMs, double& OutAdaptiveMs) -> int32
+    {
+        auto Body = [&Costs, &Sink](int32 Index)
+        {
+            Sink.fetch_add(ABV_SpinWork(Costs[Index], static_cast<uint32>(Index)), std::memory_order_relaxed);
+        };
+
+        OutPlainMs = ABV_BestOf3([&]() { ParallelFor(Costs.Num(), Body); });
+        FABVExecutorStats Stats;
+        OutAdaptiveMs = ABV_BestOf3([&]() { ABV_ParallelForAdaptive(Costs.Num(), Body, &Stats); });
+
+        AddInfo(FString::Printf(TEXT("%s, %d items, 1/%d heavy: ParallelFor %.2f ms, adaptive %.2f ms (x%.2f; %d workers, %d batches, %d steals)"),
+            Name, Costs.Num(), HeavyEvery, OutPlainMs, OutAdaptiveMs, OutPlainMs / FMath::Max(OutAdaptiveMs, 1e-6),
+            Stats.NumWorkers, Stats.NumBatches, Stats.NumSteals));
+        return Stats.NumWorkers;
+    };
+
+    double ClusteredPlainMs = 0.0;
+    double ClusteredAdaptiveMs = 0.0;
+    const int32 NumWorkers = Measure(TEXT("clustered"), Clustered, ClusteredPlainMs, ClusteredAdaptiveMs);
+
+    double ScatteredPlainMs = 0.0;
+    double ScatteredAdaptiveMs = 0.0;
+    Measure(TEXT("scattered"), Scattered, ScatteredPlainMs, ScatteredAdaptiveMs);
+
+    // 单核机器上两者都是串行，没有可比的
+    if (NumWorkers < 2)
+    {
+        AddWarning(TEXT("Single worker, skipping the timing assertions"));
+        return true;
+    }
+
+    // 集中型负载是这个执行器存在的理由，必须真的更快；均匀分布时只要求不明显变慢（计时噪声留 25%）
+    TestTrue(FString::Printf(TEXT("Clustered: adaptive (%.2f ms) faster than ParallelFor (%.2f ms)"), ClusteredAdaptiveMs, ClusteredPlainMs),
+        ClusteredAdaptiveMs < ClusteredPlainMs);
+    TestTrue(FString::Printf(TEXT("Scattered: adaptive (%.2f ms) within 25%% of ParallelFor (%.2f ms)"), ScatteredAdaptiveMs, ScatteredPlainMs),
+        ScatteredAdaptiveMs <= ScatteredPlainMs * 1.25);
+
+    UE_LOG(LogTemp, Verbose, TEXT("ABV executor test sink %u"), Sink.load());
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
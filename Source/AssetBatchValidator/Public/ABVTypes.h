@@ -24,6 +24,14 @@ enum class EABVTextureKind : uint8
     Mask        // 单独的 mask/roughness/ao 等
 };
 
+// Per-platform outcome of one texture (one entry per FABVRuleSettings::PlatformProfiles)
+struct FABVPlatformResult
+{
+    FName Platform;
+    EABVIssueSeverity Severity = EABVIssueSeverity::OK;
+    FString Message;
+};
+
 struct FABVTextureIssue
 {
     FString AssetPath;
@@ -34,6 +42,98 @@ struct FABVTextureIssue
     EABVIssueSeverity Severity = EABVIssueSeverity::OK;
 
     FString Message;   // 例如 "Normal should disable sRGB"
+    TArray<FABVPlatformResult> PlatformResults;   // Severity above is the worst case over these
     bool bCanFix = false;
     bool bSelected = false;
+    bool bStale = false;   // loaded from cache, package changed since (pending revalidation)
+};
+
+// Size / format limits of one target platform
+struct FABVPlatformProfile
+{
+    FName Name;
+    int32 MaxTextureSize = 2048;
+    bool bRequirePowerOfTwo = true;
+    bool bAllowUncompressed = true;   // TC_VectorDisplacementmap, TC_HDR, ...
+};
+
+// Rule toggles shared by every validation entry point (panel, commandlet, change-list)
+struct FABVRuleSettings
+{
+    int32 MaxTextureSize = 2048;
+    bool bCheckPowerOfTwo = true;
+
+    bool bEnableNormalRules = true;
+    bool bEnableORMRules = true;
+
+    bool bCheckMipGen = false;
+    bool bCheckLODGroup = false;
+
+    // When non-empty, size / POT / format rules are evaluated per profile instead of
+    // MaxTextureSize / bCheckPowerOfTwo, all in the same visit of each texture.
+    TArray<FABVPlatformProfile> PlatformProfiles;
+};
+
+// Scheduling / fail-fast options of a scan run (not part of the rule set)
+struct FABVScanLimits
+{
+    bool bImpactOrder = false;         // visit the likely worst offenders first (opt-in: costs a file stat per asset)
+    int32 MaxErrors = 0;               // stop after this many Error results (0 = no limit)
+    double TimeBudgetSeconds = 0.0;    // stop once exceeded (0 = no limit)
+};
+
+// Group of textures whose source data is identical (bExact) or perceptually near-identical
+struct FABVDuplicateGroup
+{
+    TArray<FString> AssetPaths;   // [0] is the texture the others would be consolidated into
+    TArray<uint64> ContentHashes; // parallel to AssetPaths, source content hash when the group was found
+    bool bExact = true;
+    int64 EstimatedSavingsBytes = 0;
+};
+
+// Rough GPU footprint with full mip chain: BC1-class for color (0.5 B/px), BC5/BC7-class otherwise (1 B/px)
+inline int64 ABV_EstimateTextureBytes(int32 W, int32 H, EABVTextureKind Kind)
+{
+    const int64 Pixels = static_cast<int64>(W) * H;
+    const int64 Base = (Kind == EABVTextureKind::Color || Kind == EABVTextureKind::Unknown) ? Pixels / 2 : Pixels;
+    return Base * 4 / 3;
+}
+
+// Outcome of one source resample fix
+struct FABVResizeResult
+{
+    FString AssetPath;
+    int32 OldWidth = 0;
+    int32 OldHeight = 0;
+    int32 NewWidth = 0;
+    int32 NewHeight = 0;
+    int64 BytesSaved = 0;   // source (mip 0) bytes before - after
+};
+
+// Channel slots of a packed ORM texture
+enum class EABVPackChannel : uint8
+{
+    Occlusion = 0,   // R
+    Roughness,       // G
+    Metallic,        // B
+    Opacity,         // A (opacity / generic mask)
+    Count
+};
+
+// Sibling single-channel textures in one folder that could share one packed ORM texture
+struct FABVPackingCandidate
+{
+    FString PackagePath;                                                 // folder, e.g. /Game/Rocks
+    FString Stem;                                                        // common name, e.g. T_Rock
+    FString ChannelPaths[static_cast<int32>(EABVPackChannel::Count)];   // object path per slot, empty if absent
+    int32 Width = 0;
+    int32 Height = 0;
+    int32 NumSamplersSaved = 0;
+    int64 EstimatedSavingsBytes = 0;
+
+    FString GetPackedObjectPath() const
+    {
+        const FString Name = Stem + TEXT("_ORM");
+        return PackagePath / Name + TEXT(".") + Name;
+    }
 };
@@ -5,6 +5,14 @@
 #include "Modules/ModuleManager.h"
 #include "ABVTypes.h"
 
+struct FAssetData;
+struct FIoHash;
+class FABVSharedCache;
+class FABVSourceWatcher;
+
+// Textures whose import source files changed on disk; bReimported if they were reimported before the broadcast
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnABVSourcesChanged, const TArray<FString>& /*AssetPaths*/, bool /*bReimported*/);
+
 class FAssetBatchValidatorModule : public IModuleInterface
 {
 public:
@@ -30,11 +38,74 @@ public:
         bool bCheckMipGen,
         bool bCheckLODGroup,
         TArray<FABVTextureIssue>& OutIssues);
+    // Return false if a fail-fast limit stopped the run early; OutIssues then holds the partial (but valid) result
+    bool ValidateTextures(const FName& RootPath, bool bRecursive, const FABVRuleSettings& Rules, TArray<FABVTextureIssue>& OutIssues, const FABVScanLimits& Limits = FABVScanLimits());
+    bool ValidateAssets(const TArray<FAssetData>& Assets, const FABVRuleSettings& Rules, TArray<FABVTextureIssue>& OutIssues, const FABVScanLimits& Limits = FABVScanLimits());
+    // Per-asset step of ValidateAssets for callers that drive their own loop (streaming scan, stale revalidation):
+    // shared cache lookup, else load + evaluate + cache. RulesFingerprint is ComputeRulesFingerprint(Rules), computed
+    // once by the caller (unused without a shared cache). Returns false if AD does not load as a texture.
+    bool ValidateAsset(const FAssetData& AD, const FABVRuleSettings& Rules, const FIoHash& RulesFingerprint, FABVTextureIssue& OutIssue);
+
+    // Change-list scoped validation: only the packages behind ChangedFiles are looked up and validated,
+    // so the cost depends on the size of the change, not of the project. Returns false if a fail-fast limit stopped it.
+    bool ValidateChangedFiles(const TArray<FString>& ChangedFiles, const FABVRuleSettings& Rules, TArray<FABVTextureIssue>& OutIssues, const FABVScanLimits& Limits = FABVScanLimits());
+    // Collects changed/untracked files from `git diff` relative to DiffBase (run in the project dir).
+    // Returns false if either git call fails; OutFiles is then incomplete.
+    bool GatherGitChangedFiles(const FString& DiffBase, TArray<FString>& OutFiles) const;
+    // Maps .uasset/.umap file paths (absolute, or relative to the project dir) to long package names
+    static void ConvertFilesToPackageNames(const TArray<FString>& Files, TArray<FName>& OutPackageNames);
+    // Registry lookup behind ValidateChangedFiles: one by-package query per changed package, keeps the textures
+    static void FindTexturesInPackages(const TArray<FName>& PackageNames,
+        TFunctionRef<void(FName /*PackageName*/, TArray<FAssetData>& /*OutAssets*/)> GetAssetsByPackage, TArray<FAssetData>& OutAssets);
+
+    // Duplicate detection over texture sources (content hash + perceptual hash, cached per package hash)
+    void FindDuplicateTextures(const FName& RootPath, bool bRecursive, int32 NearThreshold, TArray<FABVDuplicateGroup>& OutGroups);
+    // One Warning row per redundant texture, for the result list / CSV
+    static void DuplicateGroupsToIssues(const TArray<FABVDuplicateGroup>& Groups, TArray<FABVTextureIssue>& OutIssues);
+    // Replaces references to the redundant textures with AssetPaths[0] and deletes them after the editor's delete
+    // confirmation. Textures whose source changed since the group was found are skipped. Returns textures consolidated.
+    int32 ConsolidateDuplicates(const TArray<FABVDuplicateGroup>& Groups, bool bIncludeNearDuplicates);
+
+    // Channel packing: sibling single-channel textures (T_X_AO / T_X_Roughness / T_X_Metallic / T_X_Opacity) that could be one ORM
+    void FindPackingCandidates(const FName& RootPath, bool bRecursive, TArray<FABVPackingCandidate>& OutCandidates);
+    // One Warning row per candidate (on its first source texture), for the result list / CSV
+    static void PackingCandidatesToIssues(const TArray<FABVPackingCandidate>& Candidates, TArray<FABVTextureIssue>& OutIssues);
+    // Creates <Stem>_ORM next to the sources (R=AO, G=Roughness, B=Metallic, A=Opacity). Materials are not rewired.
+    int32 PackChannels(const TArray<FABVPackingCandidate>& Candidates, TArray<FString>& OutCreatedPaths);
+
+    static EABVTextureKind GuessKindFromName(const FString& ObjectPath);
+
+    // Target-platform profiles from [AssetBatchValidator] in the editor ini
+    void ReloadPlatformProfiles();
+    const TArray<FABVPlatformProfile>& GetPlatformProfiles() const { return PlatformProfiles; }
+
+    // Shared team cache (SharedCacheDir / SharedCacheMaxMB in [AssetBatchValidator], or ABV_SHARED_CACHE env).
+    // Empty directory disables it. ValidateAssets reads it before loading a texture and populates it after.
+    void SetSharedCacheDirectory(const FString& Directory, int64 MaxBytes);
+    FABVSharedCache* GetSharedCache() const { return SharedCache.Get(); }
+
+    // Import source watcher (editor only; bWatchImportSources / bReimportChangedSources in [AssetBatchValidator])
+    FOnABVSourcesChanged& OnSourcesChanged() { return SourcesChangedEvent; }
+
     // Fix: returns number of textures actually changed
     int32 FixTextures(const TArray<FABVTextureIssue>& IssuesToFix, int32 MaxTextureSize);
+    // Same, and reports the object paths of the changed textures so callers can revalidate just those
+    int32 FixTextures(const TArray<FABVTextureIssue>& IssuesToFix, int32 MaxTextureSize, TArray<FString>& OutChangedPaths);
+    // Resamples texture sources (Lanczos-3, sRGB-aware) down to MaxTextureSize and/or down to a power of two (never upsampled).
+    // Unlike FixTextures this shrinks the stored source, so packages, DDC and import time shrink too.
+    int32 ResizeTextureSources(const TArray<FABVTextureIssue>& Issues, int32 MaxTextureSize, bool bMakePowerOfTwo, TArray<FABVResizeResult>& OutResults);
     bool ExportReportCSV(const TArray<FABVTextureIssue>& Issues, const FString& FilePath);
     
 private:
     FName TargetFolder = FName("/Game");
     bool bRecursiveScan = true;
+    TArray<FABVPlatformProfile> PlatformProfiles;
+    TSharedPtr<FABVSharedCache> SharedCache;
+
+    void LoadSharedCacheSettings();
+
+    TSharedPtr<FABVSourceWatcher> SourceWatcher;
+    FOnABVSourcesChanged SourcesChangedEvent;
+    FDelegateHandle FilesLoadedHandle;
+    void StartSourceWatcher();
 };